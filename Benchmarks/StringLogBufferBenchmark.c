@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "StringLogBuffer.h"
+
+// Measures records/s of StringLogBuffer for 1..N producer threads with one draining consumer.
+// Same appends and drains guarded by one mutex are measured as baseline for the compare and swap claim.
+// Usage: StringLogBufferBenchmark [maxThreads] [recordsPerThread]
+
+#define LOG_CAPACITY (64 * 1024)
+#define DEFAULT_MAX_THREADS 8
+#define DEFAULT_RECORDS_PER_THREAD 200000
+
+typedef struct BenchmarkContext {
+    StringLogBuffer *log;
+    pthread_mutex_t *lock;      // NULL for lock free appends and drains
+    uint32_t recordCount;
+    uint32_t threadId;
+} BenchmarkContext;
+
+static bool countRecord(StringView record, void *context) {
+    (void) record;
+    (*(uint64_t *) context)++;
+    return true;
+}
+
+static void *producerThread(void *arg) {
+    BenchmarkContext *context = arg;
+    BufferString *record = EMPTY_STRING(64);
+    for (uint32_t i = 0; i < context->recordCount; i++) {
+        clearString(record);
+        stringFormat(record, "thread %u record %u", context->threadId, i);
+        while (true) {
+            if (context->lock != NULL) pthread_mutex_lock(context->lock);
+            StringLogBuffer *result = appendLogString(context->log, record);
+            if (context->lock != NULL) pthread_mutex_unlock(context->lock);
+            if (result != NULL) break;
+            sched_yield();  // full buffer, wait for consumer
+        }
+    }
+    return NULL;
+}
+
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double) (end.tv_sec - start->tv_sec) + (double) (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static double measureRecordsPerSecond(uint32_t threadCount, uint32_t recordsPerThread, pthread_mutex_t *lock) {
+    static uint32_t buffer[LOG_CAPACITY / sizeof(uint32_t)];
+    StringLogBuffer *log = NEW_STRING_LOG_BUFFER_BUFF(buffer);
+    pthread_t threads[threadCount];
+    BenchmarkContext contexts[threadCount];
+    uint64_t expectedCount = (uint64_t) threadCount * recordsPerThread;
+    uint64_t drainedCount = 0;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        contexts[i] = (BenchmarkContext) {.log = log, .lock = lock, .recordCount = recordsPerThread, .threadId = i};
+        pthread_create(&threads[i], NULL, producerThread, &contexts[i]);
+    }
+    while (drainedCount < expectedCount) {
+        if (lock != NULL) pthread_mutex_lock(lock);
+        uint32_t drained = drainStringLog(log, countRecord, &drainedCount, UINT32_MAX);
+        if (lock != NULL) pthread_mutex_unlock(lock);
+        if (drained == 0) {
+            sched_yield();
+        }
+    }
+    double seconds = elapsedSeconds(&start);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return (double) expectedCount / seconds;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t maxThreads = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DEFAULT_MAX_THREADS;
+    uint32_t recordsPerThread = argc > 2 ? (uint32_t) strtoul(argv[2], NULL, 10) : DEFAULT_RECORDS_PER_THREAD;
+    if (maxThreads == 0 || recordsPerThread == 0) {
+        fprintf(stderr, "Usage: %s [maxThreads] [recordsPerThread]\n", argv[0]);
+        return 1;
+    }
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    printf("%-8s %16s %16s\n", "threads", "CAS records/s", "mutex records/s");
+    for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount++) {
+        double lockFree = measureRecordsPerSecond(threadCount, recordsPerThread, NULL);
+        double locked = measureRecordsPerSecond(threadCount, recordsPerThread, &lock);
+        printf("%-8u %16.0f %16.0f\n", threadCount, lockFree, locked);
+    }
+    return 0;
+}
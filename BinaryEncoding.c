@@ -0,0 +1,346 @@
+#include "BinaryEncoding.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#define STRING_END(s) ((s)->value + (s)->length)
+#define INVALID_DIGIT 0xFF
+#define BASE64_PAD '='
+#define LOWER_HEX_DIGITS "0123456789abcdef"
+#define UPPER_HEX_DIGITS "0123456789ABCDEF"
+#define HEXDUMP_OFFSET_DIGITS 8
+// offset, two spaces, "XX " per byte with group spaces, " |", ASCII and "|\n"
+#define HEXDUMP_MAX_ROW_LENGTH (HEXDUMP_OFFSET_DIGITS + 2 + HEXDUMP_MAX_ROW_WIDTH * 4 + 2 + HEXDUMP_MAX_ROW_WIDTH + 2)
+#define IS_VALID_HEXDUMP_FORMAT(format) ((format)->rowWidth > 0 && (format)->rowWidth <= HEXDUMP_MAX_ROW_WIDTH)
+
+static const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const uint8_t BASE64_VALUES[256] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+        0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static BufferString *appendDecoded(BufferString *str, uint32_t initialLength, uint32_t decodedLength, bool isValid);
+static uint32_t hexEncodeBlocks(const uint8_t *data, uint32_t length, char *output, bool isUpperCase);
+static uint32_t hexDecodeBlocks(const char *hex, uint32_t length, uint8_t *output);
+static inline uint8_t hexDigitValue(char hexChar);
+static uint32_t base64EncodeBlocks(const uint8_t *data, uint32_t length, char *output);
+static uint32_t base64DecodeBlocks(const char *base64, uint32_t length, uint8_t *output);
+static uint32_t renderHexdumpRow(char *row, const uint8_t *data, uint32_t length, uint32_t offset, const HexdumpFormat *format);
+
+
+BufferString *hexEncode(BufferString *str, const uint8_t *data, uint32_t length, bool isUpperCase) {
+    if (str == NULL || data == NULL || HEX_ENCODED_LENGTH((uint64_t) length) >= str->capacity - str->length) return NULL;
+    const char *digits = isUpperCase ? UPPER_HEX_DIGITS : LOWER_HEX_DIGITS;
+    char *output = STRING_END(str);
+
+    uint32_t index = hexEncodeBlocks(data, length, output, isUpperCase);
+    for (; index < length; index++) {
+        output[index * 2] = digits[data[index] >> 4];
+        output[index * 2 + 1] = digits[data[index] & 0x0F];
+    }
+    str->length += HEX_ENCODED_LENGTH(length);
+    *STRING_END(str) = '\0';
+    str->hash = 0;
+    return str;
+}
+
+BufferString *hexDecode(BufferString *str, const char *hex, uint32_t length) {
+    if (str == NULL || hex == NULL || length % 2 != 0 || length / 2 >= str->capacity - str->length) return NULL;
+    uint8_t *output = (uint8_t *) STRING_END(str);
+
+    uint32_t index = hexDecodeBlocks(hex, length, output);
+    uint8_t invalidBits = 0;
+    for (; index < length; index += 2) {
+        uint8_t high = hexDigitValue(hex[index]);
+        uint8_t low = hexDigitValue(hex[index + 1]);
+        invalidBits |= high | low;      // only invalid digit has high bits
+        output[index / 2] = (uint8_t) ((high << 4) | (low & 0x0F));
+    }
+    return appendDecoded(str, str->length, length / 2, (invalidBits & 0xF0) == 0);
+}
+
+BufferString *base64Encode(BufferString *str, const uint8_t *data, uint32_t length) {
+    if (str == NULL || data == NULL || BASE64_ENCODED_LENGTH((uint64_t) length) >= str->capacity - str->length) return NULL;
+    char *output = STRING_END(str);
+
+    uint32_t index = base64EncodeBlocks(data, length, output);
+    output += (index / 3) * 4;
+    for (; length - index >= 3; index += 3, output += 4) {
+        uint32_t triple = ((uint32_t) data[index] << 16) | ((uint32_t) data[index + 1] << 8) | data[index + 2];
+        output[0] = BASE64_ALPHABET[triple >> 18];
+        output[1] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        output[2] = BASE64_ALPHABET[(triple >> 6) & 0x3F];
+        output[3] = BASE64_ALPHABET[triple & 0x3F];
+    }
+
+    if (index < length) {
+        uint32_t triple = ((uint32_t) data[index] << 16) | ((length - index == 2) ? (uint32_t) data[index + 1] << 8 : 0);
+        output[0] = BASE64_ALPHABET[triple >> 18];
+        output[1] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        output[2] = (length - index == 2) ? BASE64_ALPHABET[(triple >> 6) & 0x3F] : BASE64_PAD;
+        output[3] = BASE64_PAD;
+    }
+    str->length += BASE64_ENCODED_LENGTH(length);
+    *STRING_END(str) = '\0';
+    str->hash = 0;
+    return str;
+}
+
+BufferString *base64Decode(BufferString *str, const char *base64, uint32_t length) {
+    if (str == NULL || base64 == NULL) return NULL;
+    if (length % 4 == 0 && length > 0 && base64[length - 1] == BASE64_PAD) {
+        length -= (base64[length - 2] == BASE64_PAD) ? 2 : 1;
+    }
+    uint32_t tailLength = length % 4;
+    if (tailLength == 1) return NULL;
+    uint32_t decodedLength = (length / 4) * 3 + (tailLength > 0 ? tailLength - 1 : 0);
+    if (decodedLength >= str->capacity - str->length) return NULL;
+
+    uint8_t *output = (uint8_t *) STRING_END(str);
+    uint8_t invalidBits = 0;
+    uint32_t index = base64DecodeBlocks(base64, length, output);
+    output += (index / 4) * 3;
+    for (; length - index >= 4; index += 4, output += 3) {
+        uint8_t first = BASE64_VALUES[(uint8_t) base64[index]];
+        uint8_t second = BASE64_VALUES[(uint8_t) base64[index + 1]];
+        uint8_t third = BASE64_VALUES[(uint8_t) base64[index + 2]];
+        uint8_t fourth = BASE64_VALUES[(uint8_t) base64[index + 3]];
+        invalidBits |= first | second | third | fourth;     // only invalid char has high bits
+        uint32_t triple = ((uint32_t) first << 18) | ((uint32_t) second << 12) | ((uint32_t) third << 6) | fourth;
+        output[0] = (uint8_t) (triple >> 16);
+        output[1] = (uint8_t) (triple >> 8);
+        output[2] = (uint8_t) triple;
+    }
+
+    if (tailLength > 0) {
+        uint8_t first = BASE64_VALUES[(uint8_t) base64[index]];
+        uint8_t second = BASE64_VALUES[(uint8_t) base64[index + 1]];
+        uint8_t third = (tailLength == 3) ? BASE64_VALUES[(uint8_t) base64[index + 2]] : 0;
+        invalidBits |= first | second | third;
+        uint32_t triple = ((uint32_t) (first & 0x3F) << 18) | ((uint32_t) (second & 0x3F) << 12) | ((uint32_t) (third & 0x3F) << 6);
+        output[0] = (uint8_t) (triple >> 16);
+        if (tailLength == 3) {
+            output[1] = (uint8_t) (triple >> 8);
+        }
+    }
+    return appendDecoded(str, str->length, decodedLength, (invalidBits & 0xC0) == 0);
+}
+
+BufferString *hexdumpToString(BufferString *str, const uint8_t *data, uint32_t length, uint32_t baseOffset, const HexdumpFormat *format) {
+    HexdumpFormat rowFormat = (format != NULL) ? *format : HEXDUMP_DEFAULT_FORMAT;
+    if (str == NULL || data == NULL || !IS_VALID_HEXDUMP_FORMAT(&rowFormat)) return NULL;
+
+    uint32_t initialLength = str->length;
+    char row[HEXDUMP_MAX_ROW_LENGTH];
+    for (uint32_t index = 0; index < length; index += rowFormat.rowWidth) {
+        uint32_t rowLength = renderHexdumpRow(row, data + index, length - index, baseOffset + index, &rowFormat);
+        if (concatCharsByLength(str, row, rowLength) == NULL) {    // rollback rows that fit
+            memset(str->value + initialLength, 0, str->length - initialLength);
+            str->length = initialLength;
+            return NULL;
+        }
+    }
+    return str;
+}
+
+StringSink *hexdumpToSink(StringSink *sink, const uint8_t *data, uint32_t length, uint32_t baseOffset, const HexdumpFormat *format) {
+    HexdumpFormat rowFormat = (format != NULL) ? *format : HEXDUMP_DEFAULT_FORMAT;
+    if (sink == NULL || data == NULL || !IS_VALID_HEXDUMP_FORMAT(&rowFormat)) return NULL;
+
+    char row[HEXDUMP_MAX_ROW_LENGTH];
+    for (uint32_t index = 0; index < length; index += rowFormat.rowWidth) {
+        uint32_t rowLength = renderHexdumpRow(row, data + index, length - index, baseOffset + index, &rowFormat);
+        if (sinkChars(sink, row, rowLength) == NULL) return NULL;
+    }
+    return sink;
+}
+
+// decoded bytes are already written after the string end, they are kept or cleared depending on validation result
+static BufferString *appendDecoded(BufferString *str, uint32_t initialLength, uint32_t decodedLength, bool isValid) {
+    if (!isValid) {
+        memset(str->value + initialLength, 0, decodedLength);
+        return NULL;
+    }
+    str->length = initialLength + decodedLength;
+    *STRING_END(str) = '\0';
+    str->hash = 0;
+    return str;
+}
+
+// encodes 16 bytes at once, returns count of encoded bytes
+static uint32_t hexEncodeBlocks(const uint8_t *data, uint32_t length, char *output, bool isUpperCase) {
+    uint32_t index = 0;
+#ifdef __SSE2__
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i maxDigit = _mm_set1_epi8(9);
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i letterOffset = _mm_set1_epi8((char) ((isUpperCase ? 'A' : 'a') - '0' - 10));
+    for (; length - index >= sizeof(__m128i); index += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (data + index));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask);
+        __m128i low = _mm_and_si128(block, nibbleMask);
+        __m128i nibbles[] = {_mm_unpacklo_epi8(high, low), _mm_unpackhi_epi8(high, low)};  // high nibble goes first
+        for (uint32_t i = 0; i < 2; i++) {
+            __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles[i], maxDigit), letterOffset);
+            __m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles[i], zeroChar), letters);
+            _mm_storeu_si128((__m128i *) (output + index * 2 + i * sizeof(__m128i)), chars);
+        }
+    }
+#endif
+    return index;
+}
+
+// decodes 32 hex chars at once, stops before block with invalid char. Returns count of decoded chars
+static uint32_t hexDecodeBlocks(const char *hex, uint32_t length, uint8_t *output) {
+    uint32_t index = 0;
+#ifdef __SSE2__
+    const __m128i beforeZero = _mm_set1_epi8('0' - 1);
+    const __m128i afterNine = _mm_set1_epi8('9' + 1);
+    const __m128i beforeA = _mm_set1_epi8('a' - 1);
+    const __m128i afterF = _mm_set1_epi8('f' + 1);
+    const __m128i lowerCaseBit = _mm_set1_epi8(0x20);
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i letterBase = _mm_set1_epi8('a' - 10);
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+    for (; length - index >= 2 * sizeof(__m128i); index += 2 * sizeof(__m128i)) {
+        __m128i bytes[2];
+        for (uint32_t i = 0; i < 2; i++) {
+            __m128i chars = _mm_loadu_si128((const __m128i *) (hex + index + i * sizeof(__m128i)));
+            __m128i lowerChars = _mm_or_si128(chars, lowerCaseBit);
+            __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, beforeZero), _mm_cmplt_epi8(chars, afterNine));
+            __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lowerChars, beforeA), _mm_cmplt_epi8(lowerChars, afterF));
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) return index;
+
+            __m128i values = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(chars, zeroChar)),
+                                          _mm_and_si128(isLetter, _mm_sub_epi8(lowerChars, letterBase)));
+            __m128i high = _mm_and_si128(values, lowByteMask);    // first char of the pair is in the low byte
+            __m128i low = _mm_srli_epi16(values, 8);
+            bytes[i] = _mm_or_si128(_mm_slli_epi16(high, 4), low);
+        }
+        _mm_storeu_si128((__m128i *) (output + index / 2), _mm_packus_epi16(bytes[0], bytes[1]));
+    }
+#endif
+    return index;
+}
+
+// encodes 12 bytes to 16 chars at once with SSSE3 byte shuffles (W. Mula, D. Lemire). Returns count of encoded bytes
+static uint32_t base64EncodeBlocks(const uint8_t *data, uint32_t length, char *output) {
+    uint32_t index = 0;
+#ifdef __SSSE3__
+    const __m128i splitBytes = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i firstAndThirdMask = _mm_set1_epi32(0x0FC0FC00);
+    const __m128i firstAndThirdShift = _mm_set1_epi32(0x04000040);
+    const __m128i secondAndFourthMask = _mm_set1_epi32(0x003F03F0);
+    const __m128i secondAndFourthShift = _mm_set1_epi32(0x01000010);
+    const __m128i maxLetterIndex = _mm_set1_epi8(51);
+    const __m128i upperCaseLimit = _mm_set1_epi8(26);
+    const __m128i upperCaseOffset = _mm_set1_epi8(13);
+    // char offsets by range: 'a'..'z', '0'..'9', '+', '/', 'A'..'Z'
+    const __m128i charOffsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                              '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    for (; length - index >= sizeof(__m128i); index += 12) {    // 16 bytes are loaded, only 12 are used
+        __m128i block = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + index)), splitBytes);
+        __m128i firstAndThird = _mm_mulhi_epu16(_mm_and_si128(block, firstAndThirdMask), firstAndThirdShift);
+        __m128i secondAndFourth = _mm_mullo_epi16(_mm_and_si128(block, secondAndFourthMask), secondAndFourthShift);
+        __m128i indices = _mm_or_si128(firstAndThird, secondAndFourth);     // 6 bit value in every byte
+
+        __m128i ranges = _mm_subs_epu8(indices, maxLetterIndex);
+        ranges = _mm_or_si128(ranges, _mm_and_si128(_mm_cmpgt_epi8(upperCaseLimit, indices), upperCaseOffset));
+        __m128i chars = _mm_add_epi8(indices, _mm_shuffle_epi8(charOffsets, ranges));
+        _mm_storeu_si128((__m128i *) (output + (index / 3) * 4), chars);
+    }
+#endif
+    return index;
+}
+
+// decodes 16 chars to 12 bytes at once with SSSE3, stops before block with invalid char. Returns count of decoded chars
+static uint32_t base64DecodeBlocks(const char *base64, uint32_t length, uint8_t *output) {
+    uint32_t index = 0;
+#ifdef __SSSE3__
+    const __m128i lowNibbleClasses = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                   0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i highNibbleClasses = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i valueOffsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i slash = _mm_set1_epi8(0x2F);
+    const __m128i mergePairs = _mm_set1_epi32(0x01400140);
+    const __m128i mergeQuads = _mm_set1_epi32(0x00011000);
+    const __m128i packBytes = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    // 16 bytes are stored, only 12 are used. Next 8 chars make sure, that extra bytes are inside the decoded value
+    for (; length - index >= sizeof(__m128i) + 8; index += sizeof(__m128i)) {
+        __m128i chars = _mm_loadu_si128((const __m128i *) (base64 + index));
+        __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), slash);
+        __m128i lowNibbles = _mm_and_si128(chars, slash);
+        __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lowNibbleClasses, lowNibbles), _mm_shuffle_epi8(highNibbleClasses, highNibbles));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) return index;
+
+        __m128i offsets = _mm_shuffle_epi8(valueOffsets, _mm_add_epi8(_mm_cmpeq_epi8(chars, slash), highNibbles));
+        __m128i values = _mm_add_epi8(chars, offsets);
+        __m128i pairs = _mm_maddubs_epi16(values, mergePairs);
+        __m128i quads = _mm_madd_epi16(pairs, mergeQuads);
+        _mm_storeu_si128((__m128i *) (output + (index / 4) * 3), _mm_shuffle_epi8(quads, packBytes));
+    }
+#endif
+    return index;
+}
+
+static inline uint8_t hexDigitValue(char hexChar) {
+    if (hexChar >= '0' && hexChar <= '9') return hexChar - '0';
+    char lowerChar = (char) (hexChar | 0x20);
+    return (lowerChar >= 'a' && lowerChar <= 'f') ? lowerChar - 'a' + 10 : INVALID_DIGIT;
+}
+
+// renders single row, that is padded to the full width when data is shorter. Returns row length
+static uint32_t renderHexdumpRow(char *row, const uint8_t *data, uint32_t length, uint32_t offset, const HexdumpFormat *format) {
+    const char *digits = format->isUpperCase ? UPPER_HEX_DIGITS : LOWER_HEX_DIGITS;
+    uint32_t rowBytes = (length < format->rowWidth) ? length : format->rowWidth;
+    char *output = row;
+
+    for (int32_t shift = (HEXDUMP_OFFSET_DIGITS - 1) * 4; shift >= 0; shift -= 4) {
+        *output++ = digits[(offset >> shift) & 0x0F];
+    }
+    *output++ = ' ';
+    *output++ = ' ';
+
+    for (uint32_t i = 0; i < format->rowWidth; i++) {
+        if (i < rowBytes) {
+            output[0] = digits[data[i] >> 4];
+            output[1] = digits[data[i] & 0x0F];
+        } else {
+            output[0] = ' ';
+            output[1] = ' ';
+        }
+        output[2] = ' ';
+        output += 3;
+        if (format->groupSize > 0 && (i + 1) % format->groupSize == 0 && i + 1 < format->rowWidth) {
+            *output++ = ' ';
+        }
+    }
+
+    *output++ = ' ';
+    *output++ = '|';
+    for (uint32_t i = 0; i < rowBytes; i++) {
+        *output++ = (data[i] >= 0x20 && data[i] < 0x7F) ? (char) data[i] : '.';
+    }
+    *output++ = '|';
+    *output++ = '\n';
+    return output - row;
+}
@@ -0,0 +1,73 @@
+#include "BinaryLog.h"
+
+static inline void writeUInt16(uint8_t *data, uint16_t value);
+static inline uint16_t readUInt16(const uint8_t *data);
+
+
+BufferString *encodeBinaryLog(BufferString *out, uint16_t formatId, const char *format, ...) {
+    if (out == NULL || format == NULL || (out->capacity - out->length) <= BINARY_LOG_HEADER_SIZE) return NULL;
+    uint8_t *record = (uint8_t *) out->value + out->length;
+    uint32_t argumentsCapacity = out->capacity - out->length - BINARY_LOG_HEADER_SIZE - 1;  // keep space for null terminator
+    if (argumentsCapacity > BINARY_LOG_MAX_ARGUMENTS_LENGTH) {
+        argumentsCapacity = BINARY_LOG_MAX_ARGUMENTS_LENGTH;
+    }
+
+    DeferredFormat *arguments = newDeferredFormat(&(DeferredFormat){0}, record + BINARY_LOG_HEADER_SIZE, argumentsCapacity);
+    va_list vaList;
+    va_start(vaList, format);
+    arguments = deferFormatList(arguments, format, vaList);
+    va_end(vaList);
+
+    if (arguments == NULL) {
+        memset(record, 0, BINARY_LOG_HEADER_SIZE + argumentsCapacity);     // remove partially written record
+        return NULL;
+    }
+    writeUInt16(record, formatId);
+    writeUInt16(record + 2, arguments->length);
+    out->length += BINARY_LOG_HEADER_SIZE + arguments->length;
+    out->hash = 0;
+    return out;
+}
+
+BinaryLogIterator getBinaryLogIterator(const char *const *formats, uint16_t formatCount, const uint8_t *data, uint32_t length) {
+    BinaryLogIterator iterator = {
+            .formats = formats,
+            .formatCount = formatCount,
+            .data = data,
+            .length = length,
+            .offset = 0,
+    };
+    return iterator;
+}
+
+bool hasNextBinaryLog(BinaryLogIterator *iterator, BufferString *line) {
+    if (iterator == NULL || iterator->formats == NULL || iterator->data == NULL || line == NULL) return false;
+    if (iterator->length - iterator->offset < BINARY_LOG_HEADER_SIZE) return false;
+
+    const uint8_t *record = iterator->data + iterator->offset;
+    uint16_t formatId = readUInt16(record);
+    uint16_t argumentsLength = readUInt16(record + 2);
+    if (iterator->length - iterator->offset - BINARY_LOG_HEADER_SIZE < argumentsLength) return false;  // wait for the rest
+    if (formatId >= iterator->formatCount || iterator->formats[formatId] == NULL) return false;
+
+    DeferredFormat arguments = {
+            .format = iterator->formats[formatId],
+            .arguments = (uint8_t *) record + BINARY_LOG_HEADER_SIZE,
+            .length = argumentsLength,
+            .capacity = argumentsLength,
+    };
+    if (renderDeferredFormat(line, &arguments) == NULL) return false;
+
+    iterator->formatId = formatId;
+    iterator->offset += BINARY_LOG_HEADER_SIZE + argumentsLength;
+    return true;
+}
+
+static inline void writeUInt16(uint8_t *data, uint16_t value) {
+    data[0] = (uint8_t) value;
+    data[1] = (uint8_t) (value >> 8);
+}
+
+static inline uint16_t readUInt16(const uint8_t *data) {
+    return (uint16_t) (data[0] | (data[1] << 8));
+}
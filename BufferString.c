@@ -2,6 +2,7 @@
 
 #define TERMINATE_STRING(s) (s)->value[(s)->length] = '\0'
 #define STRING_END(s) ((s)->value + (s)->length)
+#define RESET_HASH(s) (s)->hash = 0     // every function that modifies string content should invalidate cached hash
 #define UINT64_DIGITS_MAX_COUNT 20
 
 #define BIT_READ(value, bit) (((value) >> (bit)) & 0x01)
@@ -30,6 +31,14 @@
 #define FORMAT_NUMBER_BUFFER_SIZE 66
 #define POINTER_DEFAULT_WIDTH (sizeof(void *) * 2)
 
+#define XXH32_STRIPE_SIZE 16
+#define XXH32_PRIME_1 0x9E3779B1U
+#define XXH32_PRIME_2 0x85EBCA77U
+#define XXH32_PRIME_3 0xC2B2AE3DU
+#define XXH32_PRIME_4 0x27D4EB2FU
+#define XXH32_PRIME_5 0x165667B1U
+#define ROTATE_LEFT_32(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
+
 #define IS_INT_8(length) ((length)[0] == '8')
 #define IS_INT_16(length) ((length)[0] == '1' && (length)[1] == '6')
 #define IS_INT_64(length) ((length)[0] == '6' && (length)[1] == '4')
@@ -79,11 +88,17 @@ typedef enum FormatFlagField {
 } FormatFlagField;
 
 static uint32_t isDelimiterChar(char valueChar, const char *delimiters, uint32_t length);
+static inline uint32_t readUInt32(const uint8_t *data);
 static uint8_t parseFormatFlags(const char *format, uint8_t *flags);
 static uint8_t parseFormatFieldWith(const char *format, va_list *vaList, int32_t *widthField, uint8_t *flags);
 static uint8_t parseFormatPrecision(const char *format, va_list *vaList, int32_t *precision);
 static uint8_t parseLengthField(char *lengthField, const char *format);
 
+static BufferString *formatToString(BufferString *str, const char *format, va_list *vaList);
+static BufferString *formatSpecifier(BufferString *str, const char **format, va_list *vaList);
+static bool trySinkSpecifier(StringSink *sink, const char **format, va_list *vaList);
+static StringSink *sinkLongString(StringSink *sink, const char **format, va_list *vaList);
+static StringSink *sinkRepeatChar(StringSink *sink, char repeatChar, int32_t count);
 static BufferString *formatCharacter(BufferString *str, uint8_t flags, int32_t widthField, va_list *vaList);
 static BufferString *formatChars(BufferString *str, uint8_t flags, int32_t widthField, int32_t precision, va_list *vaList);
 static BufferString *formatString(BufferString *str, uint8_t flags, int32_t widthField, int64_t precision, va_list *vaList);
@@ -121,6 +136,7 @@ BufferString *newStringWithLength(BufferString *str, const void *initValue, uint
     str->value = buffer;
     str->length = initLength;
     str->capacity = bufferLength;
+    RESET_HASH(str);
     memcpy(str->value, initValue, initLength);
     TERMINATE_STRING(str);
     return str;
@@ -140,112 +156,106 @@ BufferString *stringFormat(BufferString *str, const char *format, ...) {
     clearString(str);
     va_list vaList;
     va_start(vaList, format);
+    str = formatToString(str, format, &vaList);
+    va_end(vaList);
+    return str;
+}
 
-    for (; str != NULL && *format != '\0'; format++) {
+BufferString *concatFormat(BufferString *str, const char *format, ...) {
+    if (str == NULL || format == NULL) return NULL;
+    va_list vaList;
+    va_start(vaList, format);
+    str = formatToString(str, format, &vaList);
+    va_end(vaList);
+    return str;
+}
+
+StringSink *newStringSink(StringSink *sink, BufferString *buffer, StringSinkFlush flush, void *context) {
+    if (sink == NULL || buffer == NULL || flush == NULL || buffer->capacity < 2) return NULL;
+    sink->buffer = clearString(buffer);
+    sink->flush = flush;
+    sink->context = context;
+    return sink;
+}
+
+StringSink *sinkFormat(StringSink *sink, const char *format, ...) {
+    if (sink == NULL || format == NULL) return NULL;
+    va_list vaList;
+    va_start(vaList, format);
+
+    while (sink != NULL && *format != '\0') {
         if (*format != '%') {
-            str = concatChar(str, *format);
+            const char *literalEnd = strchr(format, '%');
+            uint32_t literalLength = (literalEnd != NULL) ? (literalEnd - format) : strlen(format);
+            sink = sinkChars(sink, format, literalLength);
+            format += literalLength;
             continue;
         }
 
-        format++;   // skip also '%'
-        uint8_t flags = 0;
-        format += parseFormatFlags(format, &flags);
-
-        int32_t widthField = NO_RESULT;
-        format += parseFormatFieldWith(format, &vaList, &widthField, &flags);
-
-        int32_t precisionField = NO_RESULT;
-        format += parseFormatPrecision(format, &vaList, &precisionField);
-
-        char lengthField[LENGTH_FIELD_MAX_SIZE] = {0};
-        format += parseLengthField(lengthField, format);
-
-        uint8_t base = DEC_BASE;    // default base
-        switch (*format) {
-            case 'c':
-                str = formatCharacter(str, flags, widthField - 1, &vaList);
-                continue;
-            case 's':
-                str = formatChars(str, flags, widthField, precisionField, &vaList);
-                continue;
-            case 'S':
-                str = formatString(str, flags, widthField, precisionField, &vaList);
-                continue;
-            case 'p':
-                str = formatPointer(str, flags, widthField, precisionField, (uintptr_t) va_arg(vaList, void *));
-                continue;
-            case 'n':   // Print nothing, but writes the number of characters written so far into an integer pointer parameter.
-                str = concatChar(str, '\n');    // BufferString holds string length, so no need to count this. Just add new line like in Java 
-                continue;
-            case '%':
-                str = concatChar(str, '%');
-                continue;
-
-            case 'o':
-                base = OCT_BASE;
-                break;
-            case 'b':
-                base = BIN_BASE;
-                break;
-            case 'x':
-                SET_FLAG(flags, LOWER_CASE_FLAG);
-                // fall through
-            case 'X':
-                base = HEX_BASE;
-                break;
+        va_list specifierArgs;  // argument copy, so specifier can be formatted again when it doesn't fit
+        va_copy(specifierArgs, vaList);
+        const char *specifierEnd = format;
+        if (!trySinkSpecifier(sink, &specifierEnd, &specifierArgs)) {  // flush and try again with empty buffer
+            va_end(specifierArgs);
+            va_copy(specifierArgs, vaList);
+            specifierEnd = format;
+            sink = flushStringSink(sink);
+
+            if (sink != NULL && !trySinkSpecifier(sink, &specifierEnd, &specifierArgs)) {
+                va_end(specifierArgs);
+                va_copy(specifierArgs, vaList);
+                specifierEnd = format;
+                sink = sinkLongString(sink, &specifierEnd, &specifierArgs);  // only strings can be longer than whole buffer
+            }
+        }
 
-            case 'd':
-            case 'i':
-                SET_FLAG(flags, SIGNED_NUMBER_FLAG);
-                break;
-            case 'u':
-                break;
+        va_end(vaList);
+        va_copy(vaList, specifierArgs);
+        va_end(specifierArgs);
+        format = specifierEnd + 1;
+    }
 
-            case 'I':
-                SET_FLAG(flags, SIGNED_NUMBER_FLAG);
-                format += IS_INT_8(lengthField) ? SKIP_ONE_CHAR : SKIP_TWO_CHARS;
-                break;
-            case 'U':
-                format += IS_INT_8(lengthField) ? SKIP_ONE_CHAR : SKIP_TWO_CHARS;
-                break;
+    va_end(vaList);
+    return sink;
+}
 
-                #ifdef ENABLE_FLOAT_FORMATTING
-            case 'f':
-                SET_FLAG(flags, LOWER_CASE_FLAG);
-            case 'F':
-                str = formatFloat(str, va_arg(vaList, double), flags, widthField, precisionField);
-                continue;
-
-            case 'e':
-                SET_FLAG(flags, LOWER_CASE_FLAG);
-            case 'E':
-                str = formatExponential(str, va_arg(vaList, double), flags, widthField, precisionField);
-                continue;
-
-            case 'g':
-                SET_FLAG(flags, LOWER_CASE_FLAG);
-            case 'G':
-                SET_FLAG(flags, ADAPTIVE_EXPONENT_FLAG);
-                str = formatExponential(str, va_arg(vaList, double), flags, widthField, precisionField);
-                continue;
-                #endif
-
-            default:    // unknown char, just concatenate as is
-                str = concatChar(str, *format);
-                continue;
+StringSink *sinkChars(StringSink *sink, const char *chars, uint32_t length) {
+    if (sink == NULL || chars == NULL) return NULL;
+    BufferString *buffer = sink->buffer;
+    while (length > 0) {
+        uint32_t freeLength = buffer->capacity - buffer->length - 1;
+        if (freeLength == 0) {
+            if (flushStringSink(sink) == NULL) return NULL;
+            continue;
         }
 
-        str = formatNumber(str, flags, lengthField, widthField, precisionField, base, &vaList);
+        uint32_t chunkLength = (length < freeLength) ? length : freeLength;
+        concatCharsByLength(buffer, chars, chunkLength);
+        chars += chunkLength;
+        length -= chunkLength;
     }
+    return sink;
+}
 
-    va_end(vaList);
-    return str;
+StringSink *sinkString(StringSink *sink, BufferString *str) {
+    return str != NULL ? sinkChars(sink, str->value, str->length) : NULL;
+}
+
+StringSink *flushStringSink(StringSink *sink) {
+    if (sink == NULL) return NULL;
+    BufferString *buffer = sink->buffer;
+    if (buffer->length > 0 && !sink->flush(buffer->value, buffer->length, sink->context)) {
+        return NULL;
+    }
+    clearString(buffer);
+    return sink;
 }
 
 BufferString *concatCharsByLength(BufferString *str, const char *strToConcat, uint32_t length) {
     if (str == NULL || length >= (str->capacity - str->length)) return NULL;
     memcpy(STRING_END(str), strToConcat, length);
     str->length += length;
+    RESET_HASH(str);
     TERMINATE_STRING(str);
     return str;
 }
@@ -266,6 +276,7 @@ BufferString *concatChar(BufferString *str, char charToConcat) {
     if (str == NULL || str->length >= (str->capacity - 1)) return NULL;
     *STRING_END(str) = charToConcat;
     str->length++;
+    RESET_HASH(str);
     return str;
 }
 
@@ -273,6 +284,7 @@ BufferString *copyStringByLength(BufferString *str, const char *strToCopy, uint3
     if (str == NULL || length >= str->capacity) return NULL;
     memcpy(str->value, strToCopy, length);
     str->length = length;
+    RESET_HASH(str);
     TERMINATE_STRING(str);
     return str;
 }
@@ -281,10 +293,12 @@ BufferString *clearString(BufferString *str) {
     if (str == NULL || str->length == 0) return str;
     memset(str->value, 0, str->length);
     str->length = 0;
+    RESET_HASH(str);
     return str;
 }
 
 BufferString *toLowerCase(BufferString *str) {
+    RESET_HASH(str);
     for (uint32_t i = 0; i < str->length; i++) {
         str->value[i] = (char) tolower((int) str->value[i]);
     }
@@ -292,6 +306,7 @@ BufferString *toLowerCase(BufferString *str) {
 }
 
 BufferString *toUpperCase(BufferString *str) {
+    RESET_HASH(str);
     for (uint32_t i = 0; i < str->length; i++) {
         str->value[i] = (char) toupper((int) str->value[i]);
     }
@@ -299,6 +314,7 @@ BufferString *toUpperCase(BufferString *str) {
 }
 
 BufferString *swapCase(BufferString *str) {
+    RESET_HASH(str);
     for (uint32_t i = 0; i < str->length; i++) {
         char valueChar = str->value[i];
         str->value[i] = (char) (islower((int) valueChar) ? toupper((int) valueChar) : tolower((int) valueChar));
@@ -318,6 +334,7 @@ BufferString *replaceFirstOccurrence(BufferString *source, const char *target, c
     memmove(sourcePointer + replacementLength, sourcePointer + targetLength, tailLength);
     strncpy(sourcePointer, replacement, replacementLength);
     source->length = strlen(source->value);
+    RESET_HASH(source);
     return source;
 }
 
@@ -328,29 +345,40 @@ BufferString *replaceAllOccurrences(BufferString *source, const char *target, co
 
 BufferString *trimAll(BufferString *str) {
     if (str == NULL) return NULL;
-
-    while (isspace((unsigned char) *str->value)) {// Trim leading space
-        str->value++;
-        str->length--;
+    StringView trimmed = trimToView(str);
+    if (trimmed.value != str->value) {   // compact in place, so buffer pointer and capacity stay the same
+        memmove(str->value, trimmed.value, trimmed.length);
     }
+    str->length = trimmed.length;
+    RESET_HASH(str);
+    TERMINATE_STRING(str);
+    return str;
+}
 
-    if (*str->value == 0) { // All spaces?
-        return str;
+StringView trimToView(BufferString *str) {
+    return trimStringView(toStringView(str));
+}
+
+StringView trimStringView(StringView view) {
+    if (view.value == NULL) return view;
+    const char *startPointer = view.value;
+    const char *endPointer = view.value + view.length;
+
+    while (startPointer < endPointer && isspace((unsigned char) *startPointer)) {   // Trim leading space
+        startPointer++;
     }
 
-    // Trim trailing space
-    char *stringEnd = str->value + str->length - 1;
-    while (stringEnd > str->value && isspace((unsigned char) *stringEnd)) {
-        stringEnd--;
+    while (endPointer > startPointer && isspace((unsigned char) *(endPointer - 1))) {  // Trim trailing space
+        endPointer--;
     }
 
-    // Write new null terminator character
-    stringEnd[1] = '\0';
-    str->length = strlen(str->value);
-    return str;
+    view.value = startPointer;
+    view.length = endPointer - startPointer;
+    return view;
 }
 
 BufferString *reverseString(BufferString *str) {
+    RESET_HASH(str);
     for (uint32_t i = 0; i < (str->length / 2); i++) {
         char headChar = str->value[i];
         char tailChar = str->value[str->length - i - 1];
@@ -368,6 +396,7 @@ BufferString *capitalize(BufferString *str, const char *delimiters, uint32_t len
         length = 1;
     }
 
+    RESET_HASH(str);
     bool capitalizeNext = true;
     for (uint32_t i = 0; i < stringLength(str); i++) {
 
@@ -425,6 +454,7 @@ BufferString *substringCStrFromTo(char *source, BufferString *destination, uint3
     uint32_t subLen = (endIndex - beginIndex);
     memmove(destination->value, source + beginIndex, subLen);
     destination->length = subLen;
+    RESET_HASH(destination);
     TERMINATE_STRING(destination);
     return destination;
 }
@@ -473,6 +503,7 @@ BufferString *substringCStrBetween(char *source, BufferString *destination, cons
         if (substringLength > 0 && substringLength < destination->capacity) {  // check that substring end is found and dest have enough capacity
             strncat(destination->value, startPointer, substringLength);
             destination->length = substringLength;
+            RESET_HASH(destination);
             return destination;
         }
         return NULL;
@@ -650,6 +681,51 @@ StringToI64Status cStrToInt64(const char *str, int64_t *out, int base) {
     return STR_TO_I64_SUCCESS;
 }
 
+uint32_t stringHash(const void *data, uint32_t length) {
+    // xxHash32 by Yann Collet (https://github.com/Cyan4973/xxHash), zero seed. Fast on 32-bit MCUs without 64-bit multiply
+    const uint8_t *dataPointer = data;
+    const uint8_t *dataEnd = dataPointer + length;
+    uint32_t hash;
+
+    if (length >= XXH32_STRIPE_SIZE) {
+        uint32_t accumulators[] = {XXH32_PRIME_1 + XXH32_PRIME_2, XXH32_PRIME_2, 0, 0 - XXH32_PRIME_1};
+        const uint8_t *stripesEnd = dataEnd - XXH32_STRIPE_SIZE;
+        do {
+            for (uint8_t i = 0; i < 4; i++, dataPointer += sizeof(uint32_t)) {
+                accumulators[i] = ROTATE_LEFT_32(accumulators[i] + readUInt32(dataPointer) * XXH32_PRIME_2, 13) * XXH32_PRIME_1;
+            }
+        } while (dataPointer <= stripesEnd);
+        hash = ROTATE_LEFT_32(accumulators[0], 1) + ROTATE_LEFT_32(accumulators[1], 7) +
+               ROTATE_LEFT_32(accumulators[2], 12) + ROTATE_LEFT_32(accumulators[3], 18);
+    } else {
+        hash = XXH32_PRIME_5;
+    }
+
+    hash += length;
+    for (; (dataPointer + sizeof(uint32_t)) <= dataEnd; dataPointer += sizeof(uint32_t)) {
+        hash = ROTATE_LEFT_32(hash + readUInt32(dataPointer) * XXH32_PRIME_3, 17) * XXH32_PRIME_4;
+    }
+
+    for (; dataPointer < dataEnd; dataPointer++) {
+        hash = ROTATE_LEFT_32(hash + (*dataPointer) * XXH32_PRIME_5, 11) * XXH32_PRIME_1;
+    }
+
+    hash ^= hash >> 15;     // final avalanche
+    hash *= XXH32_PRIME_2;
+    hash ^= hash >> 13;
+    hash *= XXH32_PRIME_3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+uint32_t stringHashCode(BufferString *str) {
+    if (str == NULL) return 0;
+    if (str->hash == 0) {
+        str->hash = stringHash(str->value, str->length);   // zero hash value is not cached and will be recalculated
+    }
+    return str->hash;
+}
+
 bool isBuffStrBlank(BufferString *str) {
     return str != NULL ? isCstrBlank(str->value) : true;
 }
@@ -669,9 +745,10 @@ bool isBuffStrEquals(BufferString *one, BufferString *two) {
 
     if (one != NULL && two != NULL) {
         size_t oneLength = one->length;
-        if (oneLength == two->length) {
-            return strncmp(one->value, two->value, oneLength) == 0;
+        if (oneLength != two->length || (one->hash != 0 && two->hash != 0 && one->hash != two->hash)) {
+            return false;   // when both hashes are already cached, different strings rejected without content compare
         }
+        return memcmp(one->value, two->value, oneLength) == 0;
     }
     return false;
 }
@@ -685,7 +762,7 @@ bool isBuffStrEqualsCstr(BufferString *one, const char *two) {
         size_t oneLength = one->length;
         size_t twoLength = strnlen(two, oneLength + 1);
         if (oneLength == twoLength) {
-            return strncmp(one->value, two, oneLength) == 0;
+            return memcmp(one->value, two, oneLength) == 0;
         }
     }
     return false;
@@ -818,6 +895,12 @@ static uint32_t isDelimiterChar(char valueChar, const char *delimiters, uint32_t
     return false;
 }
 
+static inline uint32_t readUInt32(const uint8_t *data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(uint32_t));    // unaligned safe read, compiler optimizes it to single load
+    return value;
+}
+
 static uint8_t parseFormatFlags(const char *format, uint8_t *flags) {
     uint8_t flagsLength = 0;
     bool haveNextFlag = true;
@@ -911,6 +994,162 @@ static uint8_t parseLengthField(char *lengthField, const char *format) {
     return 0;
 }
 
+static BufferString *formatToString(BufferString *str, const char *format, va_list *vaList) {
+    for (; str != NULL && *format != '\0'; format++) {
+        if (*format != '%') {
+            str = concatChar(str, *format);
+            continue;
+        }
+        str = formatSpecifier(str, &format, vaList);
+    }
+    return str;
+}
+
+static BufferString *formatSpecifier(BufferString *str, const char **format, va_list *vaList) {
+    (*format)++;   // skip also '%'
+    uint8_t flags = 0;
+    *format += parseFormatFlags(*format, &flags);
+
+    int32_t widthField = NO_RESULT;
+    *format += parseFormatFieldWith(*format, vaList, &widthField, &flags);
+
+    int32_t precisionField = NO_RESULT;
+    *format += parseFormatPrecision(*format, vaList, &precisionField);
+
+    char lengthField[LENGTH_FIELD_MAX_SIZE] = {0};
+    *format += parseLengthField(lengthField, *format);
+
+    uint8_t base = DEC_BASE;    // default base
+    switch (**format) {
+        case 'c':
+            return formatCharacter(str, flags, widthField - 1, vaList);
+        case 's':
+            return formatChars(str, flags, widthField, precisionField, vaList);
+        case 'S':
+            return formatString(str, flags, widthField, precisionField, vaList);
+        case 'p':
+            return formatPointer(str, flags, widthField, precisionField, (uintptr_t) va_arg(*vaList, void *));
+        case 'n':   // Print nothing, but writes the number of characters written so far into an integer pointer parameter.
+            return concatChar(str, '\n');    // BufferString holds string length, so no need to count this. Just add new line like in Java 
+        case '%':
+            return concatChar(str, '%');
+
+        case 'o':
+            base = OCT_BASE;
+            break;
+        case 'b':
+            base = BIN_BASE;
+            break;
+        case 'x':
+            SET_FLAG(flags, LOWER_CASE_FLAG);
+            // fall through
+        case 'X':
+            base = HEX_BASE;
+            break;
+
+        case 'd':
+        case 'i':
+            SET_FLAG(flags, SIGNED_NUMBER_FLAG);
+            break;
+        case 'u':
+            break;
+
+        case 'I':
+            SET_FLAG(flags, SIGNED_NUMBER_FLAG);
+            *format += IS_INT_8(lengthField) ? SKIP_ONE_CHAR : SKIP_TWO_CHARS;
+            break;
+        case 'U':
+            *format += IS_INT_8(lengthField) ? SKIP_ONE_CHAR : SKIP_TWO_CHARS;
+            break;
+
+        #ifdef ENABLE_FLOAT_FORMATTING
+        case 'f':
+            SET_FLAG(flags, LOWER_CASE_FLAG);
+        case 'F':
+            return formatFloat(str, va_arg(*vaList, double), flags, widthField, precisionField);
+
+        case 'e':
+            SET_FLAG(flags, LOWER_CASE_FLAG);
+        case 'E':
+            return formatExponential(str, va_arg(*vaList, double), flags, widthField, precisionField);
+
+        case 'g':
+            SET_FLAG(flags, LOWER_CASE_FLAG);
+        case 'G':
+            SET_FLAG(flags, ADAPTIVE_EXPONENT_FLAG);
+            return formatExponential(str, va_arg(*vaList, double), flags, widthField, precisionField);
+        #endif
+
+        default:    // unknown char, just concatenate as is
+            return concatChar(str, **format);
+    }
+
+    return formatNumber(str, flags, lengthField, widthField, precisionField, base, vaList);
+}
+
+static bool trySinkSpecifier(StringSink *sink, const char **format, va_list *vaList) {
+    BufferString *buffer = sink->buffer;
+    uint32_t startLength = buffer->length;
+    if (formatSpecifier(buffer, format, vaList) != NULL) {
+        return true;
+    }
+
+    memset(buffer->value + startLength, 0, buffer->length - startLength);  // drop partially formatted value
+    buffer->length = startLength;
+    RESET_HASH(buffer);
+    return false;
+}
+
+static StringSink *sinkLongString(StringSink *sink, const char **format, va_list *vaList) {
+    (*format)++;   // skip '%'
+    uint8_t flags = 0;
+    *format += parseFormatFlags(*format, &flags);
+
+    int32_t widthField = NO_RESULT;
+    *format += parseFormatFieldWith(*format, vaList, &widthField, &flags);
+
+    int32_t precisionField = NO_RESULT;
+    *format += parseFormatPrecision(*format, vaList, &precisionField);
+
+    char lengthField[LENGTH_FIELD_MAX_SIZE] = {0};
+    *format += parseLengthField(lengthField, *format);
+
+    const char *valueStr;
+    uint32_t length;
+    if (**format == 's') {
+        valueStr = va_arg(*vaList, char *);
+        if (valueStr == NULL) return NULL;
+        length = (precisionField >= 0) ? strnlen(valueStr, precisionField) : strlen(valueStr);
+
+    } else if (**format == 'S') {
+        BufferString *value = va_arg(*vaList, BufferString *);
+        if (value == NULL) return NULL;
+        valueStr = value->value;
+        length = strnlen(valueStr, (precisionField >= 0 && precisionField < value->length) ? precisionField : value->length);
+
+    } else {
+        return NULL;    // other values can't be split, buffer is too small
+    }
+
+    int32_t paddingLength = (widthField > (int32_t) length) ? (widthField - (int32_t) length) : 0;
+    if (IS_FLAG_NOT_SET(flags, LEFT_ALIGN_FLAG)) {
+        sink = sinkRepeatChar(sink, ' ', paddingLength);
+    }
+    sink = sinkChars(sink, valueStr, length);
+    if (IS_FLAG_SET(flags, LEFT_ALIGN_FLAG)) {
+        sink = sinkRepeatChar(sink, ' ', paddingLength);
+    }
+    return sink;
+}
+
+static StringSink *sinkRepeatChar(StringSink *sink, char repeatChar, int32_t count) {
+    while (sink != NULL && count > 0) {
+        sink = sinkChars(sink, &repeatChar, 1);
+        count--;
+    }
+    return sink;
+}
+
 static BufferString *formatCharacter(BufferString *str, uint8_t flags, int32_t widthField, va_list *vaList) {
     if (IS_FLAG_NOT_SET(flags, LEFT_ALIGN_FLAG)) {
         while (widthField > 0) {
@@ -1053,7 +1292,7 @@ static BufferString *formatFloat(BufferString *str, double decimalValue, uint8_t
         str = concatChar(str, digitChar);
     }
 
-    if (IS_FLAG_SET(flags, LEFT_ALIGN_FLAG)) {
+    if (str != NULL && IS_FLAG_SET(flags, LEFT_ALIGN_FLAG)) {
         uint32_t endValueLength = str->length - startValueLength;
         uint32_t paddingLength = (widthField >= endValueLength) ? widthField - endValueLength : 0;
         repeatChar(str, ' ', paddingLength);
@@ -1134,7 +1373,7 @@ static BufferString *formatExponential(BufferString *str, double decimalValue, u
         str = numberToString(str, exponentValue, sign, DEC_BASE, 0, exponentMinWidth - 1, flags);
     }
 
-    if (isLeftPadFlagSet) {
+    if (str != NULL && isLeftPadFlagSet) {
         uint32_t endValueLength = str->length - startValueLength;
         uint32_t paddingLength = (widthField >= endValueLength) ? widthField - endValueLength : 0;
         repeatChar(str, ' ', paddingLength);
@@ -0,0 +1,332 @@
+#include "DeferredFormat.h"
+
+#define SPECIFIER_MAX_LENGTH 32
+#define INT32_ARGUMENT_SIZE 4
+#define INT64_ARGUMENT_SIZE 8
+#define CHARS_HEADER_SIZE 4
+
+typedef enum FormatArgumentType {
+    NO_ARGUMENT,
+    INT_ARGUMENT,
+    LONG_ARGUMENT,
+    LONG_LONG_ARGUMENT,
+    DOUBLE_ARGUMENT,
+    POINTER_ARGUMENT,
+    CHARS_ARGUMENT,
+    STRING_ARGUMENT,
+} FormatArgumentType;
+
+typedef struct FormatSpecifier {
+    FormatArgumentType type;
+    bool hasWidthArgument;
+    bool hasPrecisionArgument;
+    bool isComplete;
+    uint32_t length;            // from '%' to conversion char included
+    uint32_t widthPosition;     // position of '*' in specifier
+    uint32_t precisionPosition;
+} FormatSpecifier;
+
+static void parseFormatSpecifier(const char *format, FormatSpecifier *specifier);
+static DeferredFormat *putArgument(DeferredFormat *record, uint64_t value, uint32_t size);
+static DeferredFormat *putChars(DeferredFormat *record, const char *value, uint32_t length);
+static bool readArgument(DeferredFormat *record, uint32_t *position, uint32_t size, uint64_t *value);
+static BufferString *renderSpecifier(BufferString *str, DeferredFormat *record, uint32_t *position,
+                                     const char *format, FormatSpecifier *specifier);
+static uint32_t buildSpecifier(char *specifierFormat, const char *format, FormatSpecifier *specifier, int32_t width, int32_t precision);
+
+
+DeferredFormat *newDeferredFormat(DeferredFormat *record, uint8_t *buffer, uint32_t capacity) {
+    if (record == NULL || buffer == NULL || capacity == 0) return NULL;
+    record->format = NULL;
+    record->arguments = buffer;
+    record->length = 0;
+    record->capacity = capacity;
+    return record;
+}
+
+DeferredFormat *deferFormat(DeferredFormat *record, const char *format, ...) {
+    va_list vaList;
+    va_start(vaList, format);
+    record = deferFormatList(record, format, vaList);
+    va_end(vaList);
+    return record;
+}
+
+DeferredFormat *deferFormatList(DeferredFormat *record, const char *format, va_list vaList) {
+    DeferredFormatSignature signature;
+    if (newDeferredFormatSignature(&signature, format) == NULL) return NULL;
+    return deferSignatureFormatList(record, &signature, vaList);
+}
+
+DeferredFormatSignature *newDeferredFormatSignature(DeferredFormatSignature *signature, const char *format) {
+    if (signature == NULL || format == NULL) return NULL;
+    signature->format = format;
+    signature->argumentCount = 0;
+
+    while ((format = strchr(format, '%')) != NULL) {
+        FormatSpecifier specifier;
+        parseFormatSpecifier(format, &specifier);
+        format += specifier.length;
+
+        uint32_t count = specifier.hasWidthArgument + specifier.hasPrecisionArgument + (specifier.type != NO_ARGUMENT);
+        if (signature->argumentCount + count > DEFERRED_FORMAT_MAX_ARGUMENTS) return NULL;
+        if (specifier.hasWidthArgument) {
+            signature->argumentTypes[signature->argumentCount++] = INT_ARGUMENT;
+        }
+        if (specifier.hasPrecisionArgument) {
+            signature->argumentTypes[signature->argumentCount++] = INT_ARGUMENT;
+        }
+        if (specifier.type != NO_ARGUMENT) {
+            signature->argumentTypes[signature->argumentCount++] = specifier.type;
+        }
+    }
+    return signature;
+}
+
+DeferredFormat *deferSignatureFormat(DeferredFormat *record, DeferredFormatSignature *signature, ...) {
+    va_list vaList;
+    va_start(vaList, signature);
+    record = deferSignatureFormatList(record, signature, vaList);
+    va_end(vaList);
+    return record;
+}
+
+DeferredFormat *deferSignatureFormatList(DeferredFormat *record, DeferredFormatSignature *signature, va_list vaList) {
+    if (record == NULL || signature == NULL || signature->format == NULL) return NULL;
+    record->format = signature->format;
+    record->length = 0;
+
+    for (uint32_t i = 0; record != NULL && i < signature->argumentCount; i++) {
+        switch ((FormatArgumentType) signature->argumentTypes[i]) {
+            case INT_ARGUMENT:  // also '*' width and precision
+                record = putArgument(record, (uint32_t) va_arg(vaList, int), INT32_ARGUMENT_SIZE);
+                break;
+            case LONG_ARGUMENT:     // always 64 bit, so records are the same on all platforms
+                record = putArgument(record, (uint64_t) va_arg(vaList, long), INT64_ARGUMENT_SIZE);
+                break;
+            case LONG_LONG_ARGUMENT:
+                record = putArgument(record, (uint64_t) va_arg(vaList, long long), INT64_ARGUMENT_SIZE);
+                break;
+            case DOUBLE_ARGUMENT: {
+                double value = va_arg(vaList, double);
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                record = putArgument(record, bits, INT64_ARGUMENT_SIZE);
+                break;
+            }
+            case POINTER_ARGUMENT:
+                record = putArgument(record, (uintptr_t) va_arg(vaList, void *), INT64_ARGUMENT_SIZE);
+                break;
+            case CHARS_ARGUMENT: {
+                const char *value = va_arg(vaList, const char *);
+                record = (value != NULL) ? putChars(record, value, strlen(value)) : NULL;
+                break;
+            }
+            case STRING_ARGUMENT: {
+                BufferString *value = va_arg(vaList, BufferString *);
+                record = (value != NULL) ? putChars(record, value->value, value->length) : NULL;
+                break;
+            }
+            case NO_ARGUMENT:
+                break;
+        }
+    }
+    return record;
+}
+
+BufferString *renderDeferredFormat(BufferString *str, DeferredFormat *record) {
+    if (str == NULL || record == NULL || record->format == NULL) return NULL;
+    clearString(str);
+    const char *format = record->format;
+    uint32_t position = 0;
+
+    while (str != NULL && *format != '\0') {
+        const char *specifierStart = strchr(format, '%');
+        if (specifierStart == NULL) {
+            return concatChars(str, format);
+        }
+
+        str = concatCharsByLength(str, format, specifierStart - format);
+        FormatSpecifier specifier;
+        parseFormatSpecifier(specifierStart, &specifier);
+        str = renderSpecifier(str, record, &position, specifierStart, &specifier);
+        format = specifierStart + specifier.length;
+    }
+    return str;
+}
+
+static void parseFormatSpecifier(const char *format, FormatSpecifier *specifier) {
+    const char *start = format;
+    memset(specifier, 0, sizeof(FormatSpecifier));
+    format++;   // skip '%'
+    while (*format == '-' || *format == '+' || *format == ' ' || *format == '0' || *format == '#') {
+        format++;
+    }
+
+    if (*format == '*') {
+        specifier->hasWidthArgument = true;
+        specifier->widthPosition = format++ - start;
+    }
+    while (isdigit((int) *format)) format++;
+
+    if (*format == '.') {
+        format++;
+        if (*format == '*') {
+            specifier->hasPrecisionArgument = true;
+            specifier->precisionPosition = format++ - start;
+        }
+        while (isdigit((int) *format)) format++;
+    }
+
+    FormatArgumentType integerType = INT_ARGUMENT;
+    if (*format == 'h' || *format == 'l' || *format == 'L') {
+        if (format[0] == 'l') {
+            integerType = (format[1] == 'l') ? LONG_LONG_ARGUMENT : LONG_ARGUMENT;
+        }
+        format += (format[1] == 'h' || format[1] == 'l') ? 2 : 1;
+    }
+
+    switch (*format) {
+        case 'I':
+        case 'U':   // custom fields as U8, I8, U16, I16, U32, I32, U64, I64
+            specifier->type = (format[1] == '6' && format[2] == '4') ? LONG_LONG_ARGUMENT : INT_ARGUMENT;
+            format += (format[1] == '8') ? 1 : 2;
+            break;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'b':
+        case 'x':
+        case 'X':
+            specifier->type = integerType;
+            break;
+        case 'c':
+            specifier->type = INT_ARGUMENT;
+            break;
+        case 'p':
+            specifier->type = POINTER_ARGUMENT;
+            break;
+        case 's':
+            specifier->type = CHARS_ARGUMENT;
+            break;
+        case 'S':
+            specifier->type = STRING_ARGUMENT;
+            break;
+        #ifdef ENABLE_FLOAT_FORMATTING
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+            specifier->type = DOUBLE_ARGUMENT;
+            break;
+        #endif
+        case '\0':  // unfinished specifier at the end of format
+            specifier->length = format - start;
+            return;
+        default:
+            specifier->type = NO_ARGUMENT;
+            break;
+    }
+    specifier->isComplete = true;
+    specifier->length = format - start + 1;
+}
+
+static DeferredFormat *putArgument(DeferredFormat *record, uint64_t value, uint32_t size) {
+    if (record->capacity - record->length < size) return NULL;
+    uint8_t *argument = record->arguments + record->length;
+    for (uint32_t i = 0; i < size; i++) {
+        argument[i] = (uint8_t) (value >> (i * 8));
+    }
+    record->length += size;
+    return record;
+}
+
+static DeferredFormat *putChars(DeferredFormat *record, const char *value, uint32_t length) {
+    if (record->capacity - record->length < CHARS_HEADER_SIZE + length + 1) return NULL;
+    putArgument(record, length, CHARS_HEADER_SIZE);
+    memcpy(record->arguments + record->length, value, length);
+    record->arguments[record->length + length] = '\0';    // value is rendered directly from record
+    record->length += length + 1;
+    return record;
+}
+
+static bool readArgument(DeferredFormat *record, uint32_t *position, uint32_t size, uint64_t *value) {
+    if (record->length - *position < size) return false;
+    const uint8_t *argument = record->arguments + *position;
+    *value = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        *value |= (uint64_t) argument[i] << (i * 8);
+    }
+    *position += size;
+    return true;
+}
+
+static BufferString *renderSpecifier(BufferString *str, DeferredFormat *record, uint32_t *position,
+                                     const char *format, FormatSpecifier *specifier) {
+    if (!specifier->isComplete) return str;     // nothing to render
+    uint64_t width = 0;
+    uint64_t precision = 0;
+    if ((specifier->hasWidthArgument && !readArgument(record, position, INT32_ARGUMENT_SIZE, &width)) ||
+        (specifier->hasPrecisionArgument && !readArgument(record, position, INT32_ARGUMENT_SIZE, &precision))) {
+        return NULL;
+    }
+
+    char specifierFormat[SPECIFIER_MAX_LENGTH] = {0};
+    if (buildSpecifier(specifierFormat, format, specifier, (int32_t) width, (int32_t) precision) == 0) return NULL;
+
+    uint64_t value = 0;
+    switch (specifier->type) {
+        case INT_ARGUMENT:
+            return readArgument(record, position, INT32_ARGUMENT_SIZE, &value) ? concatFormat(str, specifierFormat, (int) value) : NULL;
+        case LONG_ARGUMENT:
+            return readArgument(record, position, INT64_ARGUMENT_SIZE, &value) ? concatFormat(str, specifierFormat, (long) value) : NULL;
+        case LONG_LONG_ARGUMENT:
+            return readArgument(record, position, INT64_ARGUMENT_SIZE, &value) ? concatFormat(str, specifierFormat, (long long) value) : NULL;
+        case DOUBLE_ARGUMENT: {
+            double decimalValue;
+            if (!readArgument(record, position, INT64_ARGUMENT_SIZE, &value)) return NULL;
+            memcpy(&decimalValue, &value, sizeof(decimalValue));
+            return concatFormat(str, specifierFormat, decimalValue);
+        }
+        case POINTER_ARGUMENT:
+            return readArgument(record, position, INT64_ARGUMENT_SIZE, &value) ? concatFormat(str, specifierFormat, (void *) (uintptr_t) value) : NULL;
+        case CHARS_ARGUMENT:
+        case STRING_ARGUMENT: {
+            if (!readArgument(record, position, CHARS_HEADER_SIZE, &value) ||
+                record->length - *position < value + 1 || record->arguments[*position + value] != '\0') {
+                return NULL;
+            }
+            const char *chars = (const char *) record->arguments + *position;
+            *position += value + 1;
+            return concatFormat(str, specifierFormat, chars);
+        }
+        case NO_ARGUMENT:
+            return concatFormat(str, specifierFormat);
+    }
+    return NULL;
+}
+
+// copies specifier from format with '*' replaced by captured values and "%S" replaced by "%s"
+static uint32_t buildSpecifier(char *specifierFormat, const char *format, FormatSpecifier *specifier, int32_t width, int32_t precision) {
+    BufferString *result = newStringWithLength(&(BufferString){0}, "", 0, specifierFormat, SPECIFIER_MAX_LENGTH);
+    for (uint32_t i = 0; result != NULL && i < specifier->length; i++) {
+        if (specifier->hasWidthArgument && i == specifier->widthPosition) {
+            result = concatFormat(result, "%d", width);     // negative width becomes '-' flag
+
+        } else if (specifier->hasPrecisionArgument && i == specifier->precisionPosition) {
+            if (precision < 0) {    // negative precision is the same as omitted one
+                result->value[--result->length] = '\0';    // remove '.'
+                continue;
+            }
+            result = concatFormat(result, "%d", precision);
+
+        } else {
+            char specifierChar = (specifier->type == STRING_ARGUMENT && i == specifier->length - 1) ? 's' : format[i];
+            result = concatChar(result, specifierChar);
+        }
+    }
+    return result != NULL ? result->length : 0;
+}
@@ -0,0 +1,270 @@
+#include "GlobPattern.h"
+
+#define NOT_FOUND_INDEX UINT32_MAX
+#define ALL_CHARS 256
+
+static uint32_t parseGlobToken(GlobPattern *glob, const char *pattern, uint32_t index, GlobToken *token, uint64_t bit);
+static uint32_t parseGlobClass(GlobPattern *glob, const char *pattern, uint32_t index, uint64_t bit);
+static bool addCharsBit(GlobPattern *glob, const uint64_t *members, bool isNegated, uint64_t bit);
+static inline uint64_t charMask(GlobPattern *glob, char textChar);
+static void linkLiteralSegment(GlobToken *segment, uint16_t length);
+static inline bool isTokenMatch(GlobPattern *glob, const GlobToken *token, char textChar);
+static bool isSegmentMatch(GlobPattern *glob, const GlobToken *segment, uint16_t length, const char *text);
+static uint32_t findSegment(GlobPattern *glob, const GlobToken *segment, uint16_t length, const char *text, uint32_t from, uint32_t to);
+static uint32_t findLiteralSegment(const GlobToken *segment, uint16_t length, const char *text, uint32_t from, uint32_t to);
+static uint16_t segmentLength(GlobPattern *glob, uint16_t start);
+
+
+GlobPattern *compileGlobPattern(GlobPattern *glob, GlobToken *tokens, uint16_t tokenCapacity, const char *pattern) {
+    if (glob == NULL || tokens == NULL || pattern == NULL) return NULL;
+    memset(glob, 0, sizeof(GlobPattern));
+    glob->tokens = tokens;
+    glob->tokenCapacity = tokenCapacity;
+    glob->charGroupCount = 1;
+
+    uint32_t index = 0;
+    while (pattern[index] != '\0') {
+        if (pattern[index] == '*') {
+            bool isRepeatedStar = glob->tokenCount > 0 && tokens[glob->tokenCount - 1].type == GLOB_ANY_STRING;
+            if (!isRepeatedStar) {
+                if (glob->tokenCount >= tokenCapacity) return NULL;
+                tokens[glob->tokenCount++] = (GlobToken) {.type = GLOB_ANY_STRING};
+            }
+            index++;
+            continue;
+        }
+
+        // check segment till the next star first, its kind defines how tokens are stored
+        bool isLiteral = true;
+        uint32_t segmentEnd = index;
+        while (pattern[segmentEnd] != '\0' && pattern[segmentEnd] != '*') {
+            GlobToken token = {0};
+            segmentEnd = parseGlobToken(NULL, pattern, segmentEnd, &token, 0);
+            if (segmentEnd == NOT_FOUND_INDEX) return NULL;
+            isLiteral &= token.type == GLOB_CHAR;
+        }
+        bool isAnchored = index == 0 || pattern[segmentEnd] == '\0';   // compared at the text start or end, not searched
+        bool isMasked = !isLiteral && !isAnchored;
+
+        uint16_t segmentStart = glob->tokenCount;
+        while (index < segmentEnd) {
+            if (glob->tokenCount >= tokenCapacity) return NULL;
+            tokens[glob->tokenCount] = (GlobToken) {0};
+            uint64_t bit = 0;
+            if (isMasked || pattern[index] == '[') {
+                if (glob->maskedTokenCount >= GLOB_MAX_MASKED_TOKENS) return NULL;
+                bit = 1ULL << glob->maskedTokenCount;
+                tokens[glob->tokenCount].bit = glob->maskedTokenCount++;
+            }
+            index = parseGlobToken(glob, pattern, index, &tokens[glob->tokenCount++], bit);
+            if (index == NOT_FOUND_INDEX) return NULL;  // too many char groups
+        }
+        if (isLiteral) {
+            linkLiteralSegment(&tokens[segmentStart], glob->tokenCount - segmentStart);
+        }
+    }
+    return glob;
+}
+
+bool isGlobMatch(GlobPattern *glob, StringView text) {
+    if (glob == NULL || text.value == NULL) return false;
+    GlobToken *tokens = glob->tokens;
+    uint16_t firstLength = (glob->tokenCount > 0 && tokens[0].type != GLOB_ANY_STRING) ? segmentLength(glob, 0) : 0;
+    if (firstLength == glob->tokenCount) {     // no stars, whole text should match
+        return text.length == firstLength && isSegmentMatch(glob, tokens, firstLength, text.value);
+    }
+
+    uint16_t lastStart = glob->tokenCount;
+    while (tokens[lastStart - 1].type != GLOB_ANY_STRING) {
+        lastStart--;
+    }
+    uint16_t lastLength = glob->tokenCount - lastStart;
+    if (text.length < (uint32_t) firstLength + lastLength) return false;
+    if (!isSegmentMatch(glob, tokens, firstLength, text.value)) return false;   // segments around stars are anchored
+    if (!isSegmentMatch(glob, &tokens[lastStart], lastLength, text.value + text.length - lastLength)) return false;
+
+    // leftmost occurrence of every middle segment leaves the most text for the next ones, so backtracking is not needed
+    uint32_t position = firstLength;
+    uint32_t end = text.length - lastLength;
+    for (uint16_t start = firstLength + 1; start < lastStart; start++) {
+        uint16_t length = segmentLength(glob, start);
+        uint32_t found = findSegment(glob, &tokens[start], length, text.value, position, end);
+        if (found == NOT_FOUND_INDEX) return false;
+        position = found + length;
+        start += length;
+    }
+    return true;
+}
+
+bool isGlobMatchString(GlobPattern *glob, BufferString *str) {
+    return str != NULL && isGlobMatch(glob, toStringView(str));
+}
+
+bool isStrMatchesGlob(BufferString *str, const char *pattern) {
+    GlobToken tokens[GLOB_MAX_TOKENS];
+    GlobPattern glob;
+    return compileGlobPattern(&glob, tokens, GLOB_MAX_TOKENS, pattern) != NULL && isGlobMatchString(&glob, str);
+}
+
+// returns index after the token or NOT_FOUND_INDEX when it is invalid. Sets token bit in char masks when bit is not 0
+static uint32_t parseGlobToken(GlobPattern *glob, const char *pattern, uint32_t index, GlobToken *token, uint64_t bit) {
+    switch (pattern[index]) {
+        case '?':
+            token->type = GLOB_ANY_CHAR;
+            if (bit != 0 && !addCharsBit(glob, (uint64_t[ALL_CHARS / 64]) {0}, true, bit)) return NOT_FOUND_INDEX;
+            return index + 1;
+        case '[':
+            token->type = GLOB_CLASS;
+            return parseGlobClass(glob, pattern, index, bit);
+        case '\\':
+            if (pattern[index + 1] == '\0') return NOT_FOUND_INDEX;
+            index++;
+            break;
+        default:
+            break;
+    }
+
+    token->type = GLOB_CHAR;
+    token->symbol = pattern[index];
+    if (bit != 0) {
+        uint64_t members[ALL_CHARS / 64] = {0};
+        members[(uint8_t) token->symbol / 64] = 1ULL << ((uint8_t) token->symbol % 64);
+        if (!addCharsBit(glob, members, false, bit)) return NOT_FOUND_INDEX;
+    }
+    return index + 1;
+}
+
+// returns index after closing ']', first ']' of the class is a plain char. Class chars get the bit when it is not 0
+static uint32_t parseGlobClass(GlobPattern *glob, const char *pattern, uint32_t index, uint64_t bit) {
+    index++;
+    bool isNegated = pattern[index] == '!' || pattern[index] == '^';
+    if (isNegated) index++;
+
+    uint64_t members[ALL_CHARS / 64] = {0};
+    bool isFirst = true;
+    while (pattern[index] != ']' || isFirst) {
+        isFirst = false;
+        if (pattern[index] == '\\' && pattern[index + 1] != '\0') index++;
+        if (pattern[index] == '\0') return NOT_FOUND_INDEX;
+        uint8_t rangeStart = pattern[index++];
+        uint8_t rangeEnd = rangeStart;
+        if (pattern[index] == '-' && pattern[index + 1] != ']' && pattern[index + 1] != '\0') {
+            index++;
+            if (pattern[index] == '\\' && pattern[index + 1] != '\0') index++;
+            rangeEnd = pattern[index++];
+        }
+        for (uint32_t member = rangeStart; member <= rangeEnd; member++) {
+            members[member / 64] |= 1ULL << (member % 64);
+        }
+    }
+
+    if (bit != 0 && !addCharsBit(glob, members, isNegated, bit)) return NOT_FOUND_INDEX;
+    return index + 1;
+}
+
+// adds the bit to masks of member chars. Chars are regrouped by their new masks, false when there are too many groups
+static bool addCharsBit(GlobPattern *glob, const uint64_t *members, bool isNegated, uint64_t bit) {
+    uint64_t groupMasks[GLOB_MAX_CHAR_GROUPS];
+    uint8_t groupCount = 0;
+    uint8_t group = 0;
+    for (uint32_t i = 0; i < ALL_CHARS; i++) {
+        bool isMember = (members[i / 64] & (1ULL << (i % 64))) != 0;
+        uint64_t mask = glob->groupMasks[glob->charGroups[i]] | (isMember != isNegated ? bit : 0);
+        if (groupCount == 0 || groupMasks[group] != mask) {    // neighbour chars mostly share the group
+            group = 0;
+            while (group < groupCount && groupMasks[group] != mask) {
+                group++;
+            }
+            if (group == groupCount) {
+                if (groupCount >= GLOB_MAX_CHAR_GROUPS) return false;
+                groupMasks[groupCount++] = mask;
+            }
+        }
+        glob->charGroups[i] = group;
+    }
+    memcpy(glob->groupMasks, groupMasks, groupCount * sizeof(uint64_t));
+    glob->charGroupCount = groupCount;
+    return true;
+}
+
+static inline uint64_t charMask(GlobPattern *glob, char textChar) {
+    return glob->groupMasks[glob->charGroups[(uint8_t) textChar]];
+}
+
+// KMP prefix function over the segment chars
+static void linkLiteralSegment(GlobToken *segment, uint16_t length) {
+    segment[0].failure = 0;
+    segment[0].isLiteralSegment = true;
+    uint16_t matched = 0;
+    for (uint16_t i = 1; i < length; i++) {
+        while (matched > 0 && segment[i].symbol != segment[matched].symbol) {
+            matched = segment[matched - 1].failure;
+        }
+        if (segment[i].symbol == segment[matched].symbol) {
+            matched++;
+        }
+        segment[i].failure = matched;
+        segment[i].isLiteralSegment = true;
+    }
+}
+
+static inline bool isTokenMatch(GlobPattern *glob, const GlobToken *token, char textChar) {
+    switch (token->type) {
+        case GLOB_CHAR:
+            return token->symbol == textChar;
+        case GLOB_ANY_CHAR:
+            return true;
+        default:
+            return (charMask(glob, textChar) & (1ULL << token->bit)) != 0;
+    }
+}
+
+static bool isSegmentMatch(GlobPattern *glob, const GlobToken *segment, uint16_t length, const char *text) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (!isTokenMatch(glob, &segment[i], text[i])) return false;
+    }
+    return true;
+}
+
+// returns start of the leftmost segment occurrence, that ends not after "to" index
+static uint32_t findSegment(GlobPattern *glob, const GlobToken *segment, uint16_t length, const char *text, uint32_t from, uint32_t to) {
+    if (segment[0].isLiteralSegment) return findLiteralSegment(segment, length, text, from, to);
+
+    // Shift-And: bit of every token is set while the text before matches the segment up to the token
+    uint64_t firstBit = 1ULL << segment[0].bit;
+    uint64_t lastBit = 1ULL << segment[length - 1].bit;
+    uint64_t segmentBits = (lastBit - firstBit) | lastBit;
+    uint64_t state = 0;
+    for (uint32_t i = from; i < to; i++) {
+        state = ((state << 1) | firstBit) & charMask(glob, text[i]) & segmentBits;
+        if ((state & lastBit) != 0) return i + 1 - length;
+    }
+    return NOT_FOUND_INDEX;
+}
+
+static uint32_t findLiteralSegment(const GlobToken *segment, uint16_t length, const char *text, uint32_t from, uint32_t to) {
+    uint16_t matched = 0;
+    for (uint32_t i = from; i < to; i++) {
+        if (matched == 0) {     // skip to the first char of the segment
+            const char *next = memchr(text + i, segment[0].symbol, to - i);
+            if (next == NULL) return NOT_FOUND_INDEX;
+            i = next - text;
+        }
+        while (matched > 0 && segment[matched].symbol != text[i]) {
+            matched = segment[matched - 1].failure;
+        }
+        if (segment[matched].symbol == text[i]) {
+            matched++;
+        }
+        if (matched == length) return i + 1 - length;
+    }
+    return NOT_FOUND_INDEX;
+}
+
+static uint16_t segmentLength(GlobPattern *glob, uint16_t start) {
+    uint16_t end = start;
+    while (end < glob->tokenCount && glob->tokens[end].type != GLOB_ANY_STRING) {
+        end++;
+    }
+    return end - start;
+}
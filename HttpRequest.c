@@ -0,0 +1,173 @@
+#include "HttpRequest.h"
+
+#define HTTP_VERSION_PREFIX "HTTP/"
+#define HTTP_VERSION_LENGTH 8   // "HTTP/1.1"
+#define HTTP_MAJOR_VERSION_INDEX 5
+#define HTTP_MINOR_VERSION_INDEX 7
+#define IPD_PREFIX "+IPD,"
+#define NO_LINK_ID UINT32_MAX
+
+static HttpParseStatus parseRequestLine(HttpRequest *request, StringView line);
+static HttpParseStatus parseHeaderLine(HttpRequest *request, StringView line);
+static bool isHttpTokenChar(char valueChar);
+static const char *parseIpdNumber(const char *start, const char *end, uint32_t *number);
+
+
+HttpRequest *newHttpRequest(HttpRequest *request, HttpHeader *headers, uint32_t headerCapacity) {
+    if (request == NULL || headers == NULL) return NULL;
+    memset(request, 0, sizeof(HttpRequest));
+    request->headers = headers;
+    request->headerCapacity = headerCapacity;
+    return request;
+}
+
+HttpParseStatus parseHttpRequest(HttpRequest *request, BufferString *str) {
+    if (request == NULL || str == NULL || request->offset > str->length) return HTTP_PARSE_INVALID;
+    if (request->isComplete) return HTTP_PARSE_COMPLETE;
+
+    const char *lineEnd;
+    while ((lineEnd = memchr(str->value + request->offset, '\n', str->length - request->offset)) != NULL) {
+        StringView line = {.value = str->value + request->offset, .length = lineEnd - (str->value + request->offset)};
+        if (line.length > 0 && line.value[line.length - 1] == '\r') {
+            line.length--;
+        }
+
+        HttpParseStatus status = HTTP_PARSE_PARTIAL;
+        if (!request->isRequestLineParsed) {
+            if (line.length > 0) {  // empty lines before request line are ignored
+                status = parseRequestLine(request, line);
+            }
+        } else if (line.length == 0) {
+            request->isComplete = true;
+            request->bodyOffset = lineEnd + 1 - str->value;
+            status = HTTP_PARSE_COMPLETE;
+        } else {
+            status = parseHeaderLine(request, line);
+        }
+
+        if (status != HTTP_PARSE_PARTIAL && status != HTTP_PARSE_COMPLETE) return status;
+        request->offset = lineEnd + 1 - str->value;     // line is parsed and won't be scanned again
+        if (status == HTTP_PARSE_COMPLETE) return status;
+    }
+    return HTTP_PARSE_PARTIAL;
+}
+
+StringView getHttpHeader(HttpRequest *request, const char *name) {
+    if (request == NULL || name == NULL) return (StringView) {0};
+    uint32_t nameLength = strlen(name);
+    for (uint32_t i = 0; i < request->headerCount; i++) {
+        StringView headerName = request->headers[i].name;
+        if (headerName.length == nameLength && strncasecmp(headerName.value, name, nameLength) == 0) {
+            return request->headers[i].value;
+        }
+    }
+    return (StringView) {0};
+}
+
+HttpParseStatus parseIpdFrame(StringView data, StringView *payload, uint32_t *linkId) {
+    if (data.value == NULL || payload == NULL) return HTTP_PARSE_INVALID;
+    const char *position = data.value;
+    const char *end = data.value + data.length;
+    while (position < end && (*position == '\r' || *position == '\n')) {
+        position++;
+    }
+
+    uint32_t prefixLength = sizeof(IPD_PREFIX) - 1;
+    uint32_t availableLength = end - position;
+    if (memcmp(position, IPD_PREFIX, availableLength < prefixLength ? availableLength : prefixLength) != 0) return HTTP_PARSE_INVALID;
+    if (availableLength < prefixLength) return HTTP_PARSE_PARTIAL;
+    position += prefixLength;
+
+    uint32_t firstNumber;
+    uint32_t payloadLength;
+    uint32_t id = NO_LINK_ID;
+    position = parseIpdNumber(position, end, &firstNumber);
+    if (position == NULL) return HTTP_PARSE_INVALID;
+    if (position < end && *position == ',') {   // multiple connection mode
+        id = firstNumber;
+        position = parseIpdNumber(position + 1, end, &payloadLength);
+        if (position == NULL) return HTTP_PARSE_INVALID;
+    } else {
+        payloadLength = firstNumber;
+    }
+    if (position == end) return HTTP_PARSE_PARTIAL;
+    if (*position != ':') return HTTP_PARSE_INVALID;
+    position++;
+
+    if ((uint32_t) (end - position) < payloadLength) return HTTP_PARSE_PARTIAL;
+    *payload = (StringView) {.value = position, .length = payloadLength};
+    if (linkId != NULL) {
+        *linkId = id;
+    }
+    return HTTP_PARSE_COMPLETE;
+}
+
+// METHOD SP path[?query] SP HTTP/x.y
+static HttpParseStatus parseRequestLine(HttpRequest *request, StringView line) {
+    const char *lineEnd = line.value + line.length;
+    const char *methodEnd = memchr(line.value, ' ', line.length);
+    if (methodEnd == NULL || methodEnd == line.value) return HTTP_PARSE_INVALID;
+    for (const char *methodChar = line.value; methodChar < methodEnd; methodChar++) {
+        if (!isHttpTokenChar(*methodChar)) return HTTP_PARSE_INVALID;
+    }
+
+    const char *target = methodEnd + 1;
+    const char *targetEnd = memchr(target, ' ', lineEnd - target);
+    if (targetEnd == NULL || targetEnd == target) return HTTP_PARSE_INVALID;
+
+    const char *version = targetEnd + 1;
+    if (lineEnd - version != HTTP_VERSION_LENGTH ||
+        memcmp(version, HTTP_VERSION_PREFIX, sizeof(HTTP_VERSION_PREFIX) - 1) != 0 ||
+        !isdigit((unsigned char) version[HTTP_MAJOR_VERSION_INDEX]) || version[HTTP_MAJOR_VERSION_INDEX + 1] != '.' ||
+        !isdigit((unsigned char) version[HTTP_MINOR_VERSION_INDEX])) {
+        return HTTP_PARSE_INVALID;
+    }
+    if (version[HTTP_MAJOR_VERSION_INDEX] != '1' ||
+        (version[HTTP_MINOR_VERSION_INDEX] != '0' && version[HTTP_MINOR_VERSION_INDEX] != '1')) {
+        return HTTP_PARSE_UNSUPPORTED_VERSION;
+    }
+
+    const char *queryStart = memchr(target, '?', targetEnd - target);
+    const char *pathEnd = (queryStart != NULL) ? queryStart : targetEnd;
+    request->method = (StringView) {.value = line.value, .length = methodEnd - line.value};
+    request->path = (StringView) {.value = target, .length = pathEnd - target};
+    request->query = (queryStart != NULL) ? (StringView) {.value = queryStart + 1, .length = targetEnd - queryStart - 1} : (StringView) {0};
+    request->version = (StringView) {.value = version, .length = HTTP_VERSION_LENGTH};
+    request->isRequestLineParsed = true;
+    return HTTP_PARSE_PARTIAL;
+}
+
+// name ":" OWS value OWS
+static HttpParseStatus parseHeaderLine(HttpRequest *request, StringView line) {
+    const char *colon = memchr(line.value, ':', line.length);
+    if (colon == NULL || colon == line.value) return HTTP_PARSE_INVALID;     // also rejects obsolete line folding
+    for (const char *nameChar = line.value; nameChar < colon; nameChar++) {
+        if (!isHttpTokenChar(*nameChar)) return HTTP_PARSE_INVALID;
+    }
+    if (request->headerCount >= request->headerCapacity) return HTTP_PARSE_TOO_MANY_HEADERS;
+
+    StringView value = {.value = colon + 1, .length = line.value + line.length - (colon + 1)};
+    HttpHeader *header = &request->headers[request->headerCount++];
+    header->name = (StringView) {.value = line.value, .length = colon - line.value};
+    header->value = trimStringView(value);
+    return HTTP_PARSE_PARTIAL;
+}
+
+// RFC 9110 tchar
+static bool isHttpTokenChar(char valueChar) {
+    return (valueChar >= 'a' && valueChar <= 'z') || (valueChar >= 'A' && valueChar <= 'Z') ||
+           (valueChar >= '0' && valueChar <= '9') || (valueChar != '\0' && strchr("!#$%&'*+-.^_`|~", valueChar) != NULL);
+}
+
+// decimal digits, returns position after them. NULL when there are no digits or value overflows
+static const char *parseIpdNumber(const char *start, const char *end, uint32_t *number) {
+    uint32_t value = 0;
+    const char *position = start;
+    for (; position < end && isdigit((unsigned char) *position); position++) {
+        if (value > (UINT32_MAX - 9) / 10) return NULL;
+        value = value * 10 + (*position - '0');
+    }
+    if (position == start && position < end) return NULL;
+    *number = value;
+    return position;
+}
@@ -0,0 +1,506 @@
+#include "JsonString.h"
+#include "Utf8String.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define STRING_END(s) ((s)->value + (s)->length)
+#define BYTES_OF(value) (0x0101010101010101ULL * (value))
+#define HAS_ZERO_BYTE(word) (((word) - BYTES_OF(0x01)) & ~(word) & BYTES_OF(0x80))
+#define HAS_BYTE_LESS_THAN(word, value) (((word) - BYTES_OF(value)) & ~(word) & BYTES_OF(0x80))
+#define HEX_DIGITS "0123456789abcdef"
+#define IS_HIGH_SURROGATE(codePoint) ((codePoint) >= 0xD800 && (codePoint) <= 0xDBFF)
+#define IS_LOW_SURROGATE(codePoint) ((codePoint) >= 0xDC00 && (codePoint) <= 0xDFFF)
+#define MAX_ESCAPE_SEQUENCE_LENGTH 12   // surrogate pair "\uD83D\uDE00"
+#define MAX_NUMBER_TOKEN_LENGTH 64
+#define JSON_NO_PARENT (-1)
+#define IS_DIGIT(valueChar) ((valueChar) >= '0' && (valueChar) <= '9')
+#define IS_VALUE_EXPECTED(tokenizer) ((tokenizer)->expect == EXPECT_VALUE || (tokenizer)->expect == EXPECT_VALUE_OR_END)
+
+typedef enum JsonExpect {
+    EXPECT_VALUE,
+    EXPECT_VALUE_OR_END,    // after '['
+    EXPECT_KEY,
+    EXPECT_KEY_OR_END,      // after '{'
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_NOTHING          // root value is complete
+} JsonExpect;
+
+typedef struct JsonTokenizer {
+    const char *json;
+    uint32_t length;
+    uint32_t index;
+    JsonToken *tokens;
+    uint32_t capacity;
+    uint32_t count;
+    int32_t parent;
+    JsonExpect expect;
+} JsonTokenizer;
+
+static uint32_t findEscapeChar(const uint8_t *data, uint32_t length, bool isEscapeNonAscii);
+static inline bool isEscapeChar(uint8_t valueChar, bool isEscapeNonAscii);
+static BufferString *concatEscapedChar(BufferString *str, const char *value, uint32_t length, uint32_t *index);
+static BufferString *concatUnicodeEscape(BufferString *str, uint32_t codeUnit);
+static uint32_t unescapeSequence(const char *escape, uint32_t length, char *output, uint32_t *outputLength);
+static bool parseHexCodeUnit(const char *hex, uint32_t *codeUnit);
+static uint32_t encodeUtf8(uint32_t codePoint, char *output);
+static int32_t tokenizeNext(JsonTokenizer *tokenizer);
+static int32_t beginJsonContainer(JsonTokenizer *tokenizer, JsonTokenType type);
+static int32_t endJsonContainer(JsonTokenizer *tokenizer, JsonTokenType type);
+static int32_t tokenizeJsonString(JsonTokenizer *tokenizer);
+static int32_t tokenizeJsonPrimitive(JsonTokenizer *tokenizer);
+static JsonToken *addJsonToken(JsonTokenizer *tokenizer, JsonTokenType type, uint32_t offset, uint32_t length);
+static void completeJsonValue(JsonTokenizer *tokenizer);
+static bool isJsonLiteral(const char *value, uint32_t length, const char *literal);
+static bool isJsonNumber(const char *value, uint32_t length);
+static uint32_t countDigits(const char *value, uint32_t length);
+
+
+BufferString *concatJsonEscaped(BufferString *str, const char *value, uint32_t length, bool isEscapeNonAscii) {
+    if (str == NULL || value == NULL) return NULL;
+    uint32_t initialLength = str->length;
+    uint32_t index = 0;
+    BufferString *result = str;
+
+    while (result != NULL && index < length) {
+        uint32_t plainLength = findEscapeChar((const uint8_t *) value + index, length - index, isEscapeNonAscii);
+        result = concatCharsByLength(result, value + index, plainLength);   // copy whole run of chars that need no escape
+        index += plainLength;
+
+        if (result != NULL && index < length) {
+            result = concatEscapedChar(result, value, length, &index);
+        }
+    }
+
+    if (result == NULL) {   // rollback partially escaped value
+        memset(str->value + initialLength, 0, str->length - initialLength);
+        str->length = initialLength;
+        return NULL;
+    }
+    return str;
+}
+
+BufferString *unescapeJsonString(BufferString *str) {
+    if (str == NULL) return NULL;
+    char *escape = memchr(str->value, '\\', str->length);
+    if (escape == NULL) return str;
+
+    char unescaped[4];
+    uint32_t unescapedLength;
+    for (char *check = escape; check != NULL; check = memchr(check, '\\', STRING_END(str) - check)) {    // validate before change
+        uint32_t escapeLength = unescapeSequence(check, STRING_END(str) - check, unescaped, &unescapedLength);
+        if (escapeLength == 0) return NULL;
+        check += escapeLength;
+    }
+
+    char *write = escape;
+    const char *read = escape;
+    while (read < STRING_END(str)) {
+        if (*read != '\\') {
+            const char *nextEscape = memchr(read, '\\', STRING_END(str) - read);
+            uint32_t plainLength = (nextEscape != NULL) ? nextEscape - read : STRING_END(str) - read;
+            memmove(write, read, plainLength);
+            write += plainLength;
+            read += plainLength;
+            continue;
+        }
+
+        read += unescapeSequence(read, STRING_END(str) - read, unescaped, &unescapedLength);
+        memcpy(write, unescaped, unescapedLength);
+        write += unescapedLength;
+    }
+
+    uint32_t newLength = write - str->value;
+    memset(write, 0, str->length - newLength);
+    str->length = newLength;
+    str->hash = 0;
+    return str;
+}
+
+int32_t tokenizeJson(BufferString *json, JsonToken *tokens, uint32_t capacity) {
+    if (json == NULL || tokens == NULL) return JSON_ERROR_INVALID;
+    JsonTokenizer tokenizer = {
+            .json = json->value,
+            .length = json->length,
+            .tokens = tokens,
+            .capacity = capacity,
+            .parent = JSON_NO_PARENT,
+            .expect = EXPECT_VALUE,
+    };
+
+    while (tokenizer.index < tokenizer.length) {
+        int32_t result = tokenizeNext(&tokenizer);
+        if (result < 0) return result;
+    }
+    return tokenizer.expect == EXPECT_NOTHING ? (int32_t) tokenizer.count : JSON_ERROR_PARTIAL;
+}
+
+StringView jsonTokenView(BufferString *json, JsonToken *token) {
+    if (json == NULL || token == NULL || token->offset + token->length > json->length) return (StringView) {0};
+    return (StringView) {.value = json->value + token->offset, .length = token->length};
+}
+
+bool isJsonTokenEquals(BufferString *json, JsonToken *token, const char *value) {
+    if (token == NULL || value == NULL || token->type != JSON_STRING) return false;
+    StringView view = jsonTokenView(json, token);
+    return view.value != NULL && view.length == strlen(value) && memcmp(view.value, value, view.length) == 0;
+}
+
+int32_t findJsonKey(BufferString *json, JsonToken *tokens, uint32_t count, uint32_t objectIndex, const char *key) {
+    if (tokens == NULL || objectIndex >= count || tokens[objectIndex].type != JSON_OBJECT) return -1;
+    uint32_t objectEnd = tokens[objectIndex].offset + tokens[objectIndex].length;
+    for (uint32_t i = objectIndex + 1; i + 1 < count && tokens[i].offset < objectEnd; i++) {
+        if (tokens[i].parent == (int32_t) objectIndex && isJsonTokenEquals(json, &tokens[i], key)) {
+            return (int32_t) i + 1;    // value follows the key
+        }
+    }
+    return -1;
+}
+
+StringToI64Status jsonTokenToI64(BufferString *json, JsonToken *token, int64_t *out) {
+    StringView view = jsonTokenView(json, token);
+    if (view.value == NULL || out == NULL || token->type != JSON_NUMBER) return STR_TO_I64_INCONVERTIBLE;
+
+    bool isNegative = view.value[0] == '-';
+    uint64_t limit = isNegative ? (uint64_t) INT64_MAX + 1 : INT64_MAX;
+    uint64_t result = 0;
+    for (uint32_t i = isNegative; i < view.length; i++) {
+        if (!IS_DIGIT(view.value[i])) return STR_TO_I64_INCONVERTIBLE;   // fraction or exponent
+        uint32_t digit = view.value[i] - '0';
+        if (result > (limit - digit) / 10) {
+            return isNegative ? STR_TO_I64_UNDERFLOW : STR_TO_I64_OVERFLOW;
+        }
+        result = result * 10 + digit;
+    }
+    *out = isNegative ? (int64_t) (0 - result) : (int64_t) result;
+    return STR_TO_I64_SUCCESS;
+}
+
+bool jsonTokenToDouble(BufferString *json, JsonToken *token, double *out) {
+    StringView view = jsonTokenView(json, token);
+    if (view.value == NULL || out == NULL || token->type != JSON_NUMBER || view.length >= MAX_NUMBER_TOKEN_LENGTH) {
+        return false;
+    }
+    char number[MAX_NUMBER_TOKEN_LENGTH];  // token is not terminated in the json
+    memcpy(number, view.value, view.length);
+    number[view.length] = '\0';
+    *out = strtod(number, NULL);
+    return true;
+}
+
+// returns length of chars, that don't need escaping
+static uint32_t findEscapeChar(const uint8_t *data, uint32_t length, bool isEscapeNonAscii) {
+    uint32_t index = 0;
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i maxControl = _mm_set1_epi8(0x1F);
+    for (; length - index >= sizeof(__m128i); index += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (data + index));
+        __m128i isControl = _mm_cmpeq_epi8(_mm_max_epu8(block, maxControl), maxControl);   // unsigned <= 0x1F
+        __m128i needEscape = _mm_or_si128(isControl, _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)));
+        int mask = _mm_movemask_epi8(needEscape) | (isEscapeNonAscii ? _mm_movemask_epi8(block) : 0);
+        if (mask != 0) return index + __builtin_ctz(mask);
+    }
+#endif
+    for (; length - index >= sizeof(uint64_t); index += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + index, sizeof(uint64_t));
+        uint64_t quotes = word ^ BYTES_OF('"');
+        uint64_t backslashes = word ^ BYTES_OF('\\');
+        bool isHighBitSet = (word & BYTES_OF(0x80)) != 0;
+        // high bit bytes give false positives for control chars check, so they are checked by bytes below
+        if (HAS_BYTE_LESS_THAN(word, 0x20) || HAS_ZERO_BYTE(quotes) || HAS_ZERO_BYTE(backslashes) || isHighBitSet) break;
+    }
+
+    while (index < length && !isEscapeChar(data[index], isEscapeNonAscii)) {
+        index++;
+    }
+    return index;
+}
+
+static inline bool isEscapeChar(uint8_t valueChar, bool isEscapeNonAscii) {
+    return valueChar < 0x20 || valueChar == '"' || valueChar == '\\' || (isEscapeNonAscii && valueChar >= 0x80);
+}
+
+static BufferString *concatEscapedChar(BufferString *str, const char *value, uint32_t length, uint32_t *index) {
+    uint8_t valueChar = (uint8_t) value[*index];
+    if (valueChar >= 0x80) {
+        uint8_t sequenceLength;
+        uint32_t codePoint = decodeUtf8CodePoint(value + *index, length - *index, &sequenceLength);
+        *index += sequenceLength;
+        if (codePoint <= 0xFFFF) {
+            return concatUnicodeEscape(str, codePoint);
+        }
+        codePoint -= 0x10000;   // surrogate pair
+        return concatUnicodeEscape(concatUnicodeEscape(str, 0xD800 | (codePoint >> 10)), 0xDC00 | (codePoint & 0x3FF));
+    }
+
+    (*index)++;
+    const char *shortEscape = NULL;
+    switch (valueChar) {
+        case '"': shortEscape = "\\\""; break;
+        case '\\': shortEscape = "\\\\"; break;
+        case '\b': shortEscape = "\\b"; break;
+        case '\f': shortEscape = "\\f"; break;
+        case '\n': shortEscape = "\\n"; break;
+        case '\r': shortEscape = "\\r"; break;
+        case '\t': shortEscape = "\\t"; break;
+        default:
+            return concatUnicodeEscape(str, valueChar);
+    }
+    return concatCharsByLength(str, shortEscape, 2);
+}
+
+static BufferString *concatUnicodeEscape(BufferString *str, uint32_t codeUnit) {
+    char escape[6] = {'\\', 'u',
+                      HEX_DIGITS[(codeUnit >> 12) & 0xF], HEX_DIGITS[(codeUnit >> 8) & 0xF],
+                      HEX_DIGITS[(codeUnit >> 4) & 0xF], HEX_DIGITS[codeUnit & 0xF]};
+    return concatCharsByLength(str, escape, sizeof(escape));
+}
+
+// returns escape sequence length or 0 when it is invalid. Output is UTF-8 encoded value
+static uint32_t unescapeSequence(const char *escape, uint32_t length, char *output, uint32_t *outputLength) {
+    if (length < 2) return 0;
+    *outputLength = 1;
+    switch (escape[1]) {
+        case '"': *output = '"'; return 2;
+        case '\\': *output = '\\'; return 2;
+        case '/': *output = '/'; return 2;
+        case 'b': *output = '\b'; return 2;
+        case 'f': *output = '\f'; return 2;
+        case 'n': *output = '\n'; return 2;
+        case 'r': *output = '\r'; return 2;
+        case 't': *output = '\t'; return 2;
+        case 'u':
+            break;
+        default:
+            return 0;
+    }
+
+    uint32_t codePoint;
+    if (length < 6 || !parseHexCodeUnit(escape + 2, &codePoint) || IS_LOW_SURROGATE(codePoint)) return 0;
+    if (!IS_HIGH_SURROGATE(codePoint)) {
+        *outputLength = encodeUtf8(codePoint, output);
+        return 6;
+    }
+
+    uint32_t lowSurrogate;
+    if (length < 12 || escape[6] != '\\' || escape[7] != 'u' ||
+        !parseHexCodeUnit(escape + 8, &lowSurrogate) || !IS_LOW_SURROGATE(lowSurrogate)) {
+        return 0;
+    }
+    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+    *outputLength = encodeUtf8(codePoint, output);
+    return 12;
+}
+
+static bool parseHexCodeUnit(const char *hex, uint32_t *codeUnit) {
+    *codeUnit = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+        char hexChar = hex[i];
+        uint32_t digit;
+        if (hexChar >= '0' && hexChar <= '9') {
+            digit = hexChar - '0';
+        } else if ((hexChar | 0x20) >= 'a' && (hexChar | 0x20) <= 'f') {
+            digit = (hexChar | 0x20) - 'a' + 10;
+        } else {
+            return false;
+        }
+        *codeUnit = (*codeUnit << 4) | digit;
+    }
+    return true;
+}
+
+static uint32_t encodeUtf8(uint32_t codePoint, char *output) {
+    if (codePoint < 0x80) {
+        output[0] = (char) codePoint;
+        return 1;
+    } else if (codePoint < 0x800) {
+        output[0] = (char) (0xC0 | (codePoint >> 6));
+        output[1] = (char) (0x80 | (codePoint & 0x3F));
+        return 2;
+    } else if (codePoint < 0x10000) {
+        output[0] = (char) (0xE0 | (codePoint >> 12));
+        output[1] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        output[2] = (char) (0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    output[0] = (char) (0xF0 | (codePoint >> 18));
+    output[1] = (char) (0x80 | ((codePoint >> 12) & 0x3F));
+    output[2] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+    output[3] = (char) (0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+static int32_t tokenizeNext(JsonTokenizer *tokenizer) {
+    char nextChar = tokenizer->json[tokenizer->index];
+    switch (nextChar) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            tokenizer->index++;
+            return 0;
+        case '{':
+        case '[':
+            return beginJsonContainer(tokenizer, nextChar == '{' ? JSON_OBJECT : JSON_ARRAY);
+        case '}':
+        case ']':
+            return endJsonContainer(tokenizer, nextChar == '}' ? JSON_OBJECT : JSON_ARRAY);
+        case '"':
+            return tokenizeJsonString(tokenizer);
+        case ':':
+            if (tokenizer->expect != EXPECT_COLON) return JSON_ERROR_INVALID;
+            tokenizer->parent = (int32_t) tokenizer->count - 1;  // key is the last token and becomes parent of the value
+            tokenizer->expect = EXPECT_VALUE;
+            tokenizer->index++;
+            return 0;
+        case ',':
+            if (tokenizer->expect != EXPECT_COMMA_OR_END) return JSON_ERROR_INVALID;
+            tokenizer->expect = (tokenizer->tokens[tokenizer->parent].type == JSON_OBJECT) ? EXPECT_KEY : EXPECT_VALUE;
+            tokenizer->index++;
+            return 0;
+        default:
+            return tokenizeJsonPrimitive(tokenizer);
+    }
+}
+
+static int32_t beginJsonContainer(JsonTokenizer *tokenizer, JsonTokenType type) {
+    if (!IS_VALUE_EXPECTED(tokenizer)) return JSON_ERROR_INVALID;
+    if (addJsonToken(tokenizer, type, tokenizer->index, 0) == NULL) return JSON_ERROR_NO_TOKENS;
+    tokenizer->parent = (int32_t) tokenizer->count - 1;
+    tokenizer->expect = (type == JSON_OBJECT) ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+    tokenizer->index++;
+    return 0;
+}
+
+static int32_t endJsonContainer(JsonTokenizer *tokenizer, JsonTokenType type) {
+    JsonExpect emptyExpect = (type == JSON_OBJECT) ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+    if (tokenizer->expect != EXPECT_COMMA_OR_END && tokenizer->expect != emptyExpect) return JSON_ERROR_INVALID;
+
+    JsonToken *container = &tokenizer->tokens[tokenizer->parent];  // parent is always container in these states
+    if (container->type != type) return JSON_ERROR_INVALID;
+    container->length = tokenizer->index + 1 - container->offset;
+    tokenizer->parent = container->parent;
+    tokenizer->index++;
+    completeJsonValue(tokenizer);
+    return 0;
+}
+
+static int32_t tokenizeJsonString(JsonTokenizer *tokenizer) {
+    bool isKey = tokenizer->expect == EXPECT_KEY || tokenizer->expect == EXPECT_KEY_OR_END;
+    if (!isKey && !IS_VALUE_EXPECTED(tokenizer)) return JSON_ERROR_INVALID;
+
+    const char *json = tokenizer->json;
+    uint32_t start = tokenizer->index + 1;
+    uint32_t index = start;
+    while (true) {
+        // block scan stops only on quote, backslash or control char
+        index += findEscapeChar((const uint8_t *) json + index, tokenizer->length - index, false);
+        if (index >= tokenizer->length) return JSON_ERROR_PARTIAL;
+        if (json[index] == '"') break;
+        if (json[index] != '\\') return JSON_ERROR_INVALID;  // not escaped control char
+
+        char unescaped[4];
+        uint32_t unescapedLength;
+        uint32_t escapeLength = unescapeSequence(json + index, tokenizer->length - index, unescaped, &unescapedLength);
+        if (escapeLength == 0) {
+            uint32_t remaining = tokenizer->length - index;
+            bool isTruncated = remaining < 2 || (json[index + 1] == 'u' && remaining < MAX_ESCAPE_SEQUENCE_LENGTH);
+            return isTruncated ? JSON_ERROR_PARTIAL : JSON_ERROR_INVALID;
+        }
+        index += escapeLength;
+    }
+
+    if (addJsonToken(tokenizer, JSON_STRING, start, index - start) == NULL) return JSON_ERROR_NO_TOKENS;
+    tokenizer->index = index + 1;
+    if (isKey) {
+        tokenizer->expect = EXPECT_COLON;
+    } else {
+        completeJsonValue(tokenizer);
+    }
+    return 0;
+}
+
+static int32_t tokenizeJsonPrimitive(JsonTokenizer *tokenizer) {
+    if (!IS_VALUE_EXPECTED(tokenizer)) return JSON_ERROR_INVALID;
+    const char *value = tokenizer->json + tokenizer->index;
+    uint32_t length = 0;
+    uint32_t maxLength = tokenizer->length - tokenizer->index;
+    while (length < maxLength && strchr(" \t\n\r,]}", value[length]) == NULL) {
+        length++;
+    }
+
+    JsonTokenType type;
+    if (isJsonLiteral(value, length, "true") || isJsonLiteral(value, length, "false")) {
+        type = JSON_BOOL;
+    } else if (isJsonLiteral(value, length, "null")) {
+        type = JSON_NULL;
+    } else if (isJsonNumber(value, length)) {
+        type = JSON_NUMBER;
+    } else {
+        return (length == maxLength) ? JSON_ERROR_PARTIAL : JSON_ERROR_INVALID;   // can be completed by next data
+    }
+
+    if (addJsonToken(tokenizer, type, tokenizer->index, length) == NULL) return JSON_ERROR_NO_TOKENS;
+    tokenizer->index += length;
+    completeJsonValue(tokenizer);
+    return 0;
+}
+
+static JsonToken *addJsonToken(JsonTokenizer *tokenizer, JsonTokenType type, uint32_t offset, uint32_t length) {
+    if (tokenizer->count >= tokenizer->capacity) return NULL;
+    if (tokenizer->parent != JSON_NO_PARENT) {
+        tokenizer->tokens[tokenizer->parent].size++;
+    }
+    JsonToken *token = &tokenizer->tokens[tokenizer->count++];
+    *token = (JsonToken) {.type = type, .offset = offset, .length = length, .size = 0, .parent = tokenizer->parent};
+    return token;
+}
+
+static void completeJsonValue(JsonTokenizer *tokenizer) {
+    if (tokenizer->parent != JSON_NO_PARENT && tokenizer->tokens[tokenizer->parent].type == JSON_STRING) {
+        tokenizer->parent = tokenizer->tokens[tokenizer->parent].parent;   // value of the key is done, back to the object
+    }
+    tokenizer->expect = (tokenizer->parent == JSON_NO_PARENT) ? EXPECT_NOTHING : EXPECT_COMMA_OR_END;
+}
+
+static bool isJsonLiteral(const char *value, uint32_t length, const char *literal) {
+    return length == strlen(literal) && memcmp(value, literal, length) == 0;
+}
+
+// -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+static bool isJsonNumber(const char *value, uint32_t length) {
+    uint32_t index = (length > 0 && value[0] == '-') ? 1 : 0;
+    uint32_t digits = countDigits(value + index, length - index);
+    if (digits == 0 || (digits > 1 && value[index] == '0')) return false;
+    index += digits;
+
+    if (index < length && value[index] == '.') {
+        digits = countDigits(value + index + 1, length - index - 1);
+        if (digits == 0) return false;
+        index += digits + 1;
+    }
+
+    if (index < length && (value[index] == 'e' || value[index] == 'E')) {
+        index++;
+        if (index < length && (value[index] == '+' || value[index] == '-')) {
+            index++;
+        }
+        digits = countDigits(value + index, length - index);
+        if (digits == 0) return false;
+        index += digits;
+    }
+    return index == length;
+}
+
+static uint32_t countDigits(const char *value, uint32_t length) {
+    uint32_t count = 0;
+    while (count < length && IS_DIGIT(value[count])) {
+        count++;
+    }
+    return count;
+}
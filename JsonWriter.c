@@ -0,0 +1,190 @@
+#include "JsonWriter.h"
+
+#define ARRAY_LEVEL 0x01
+#define HAS_VALUES_LEVEL 0x02
+#define MAX_ESCAPED_CHAR_LENGTH 6   // "\u001f"
+#define NUMBER_BUFFER_SIZE 32
+
+static JsonWriter *beginContainer(JsonWriter *writer, char openChar, uint8_t levelType);
+static JsonWriter *endContainer(JsonWriter *writer, char closeChar, uint8_t levelType);
+static JsonWriter *beginValue(JsonWriter *writer);
+static JsonWriter *writeChars(JsonWriter *writer, const char *chars, uint32_t length);
+static JsonWriter *writeQuoted(JsonWriter *writer, const char *value, uint32_t length);
+static JsonWriter *writeEscaped(JsonWriter *writer, const char *value, uint32_t length);
+static JsonWriter *writeNumber(JsonWriter *writer, BufferString *number);
+
+
+JsonWriter *newJsonWriter(JsonWriter *writer, BufferString *str) {
+    if (writer == NULL || str == NULL) return NULL;
+    memset(writer, 0, sizeof(JsonWriter));
+    writer->str = str;
+    return writer;
+}
+
+JsonWriter *newJsonSinkWriter(JsonWriter *writer, StringSink *sink) {
+    if (writer == NULL || sink == NULL) return NULL;
+    memset(writer, 0, sizeof(JsonWriter));
+    writer->sink = sink;
+    writer->str = sink->buffer;
+    return writer;
+}
+
+JsonWriter *jsonBeginObject(JsonWriter *writer) {
+    return beginContainer(writer, '{', 0);
+}
+
+JsonWriter *jsonEndObject(JsonWriter *writer) {
+    return endContainer(writer, '}', 0);
+}
+
+JsonWriter *jsonBeginArray(JsonWriter *writer) {
+    return beginContainer(writer, '[', ARRAY_LEVEL);
+}
+
+JsonWriter *jsonEndArray(JsonWriter *writer) {
+    return endContainer(writer, ']', ARRAY_LEVEL);
+}
+
+JsonWriter *jsonKey(JsonWriter *writer, const char *key) {
+    return key != NULL ? jsonKeyView(writer, (StringView) {.value = key, .length = strlen(key)}) : NULL;
+}
+
+JsonWriter *jsonKeyView(JsonWriter *writer, StringView key) {
+    if (writer == NULL || key.value == NULL || writer->depth == 0 || writer->isKeyWritten) return NULL;
+    uint8_t *level = &writer->levels[writer->depth - 1];
+    if ((*level & ARRAY_LEVEL) != 0) return NULL;   // arrays have no keys
+
+    if ((*level & HAS_VALUES_LEVEL) != 0) {
+        writer = writeChars(writer, ",", 1);
+    }
+    *level |= HAS_VALUES_LEVEL;
+    writer = writeQuoted(writer, key.value, key.length);
+    writer = writeChars(writer, ":", 1);
+    if (writer != NULL) {
+        writer->isKeyWritten = true;
+    }
+    return writer;
+}
+
+JsonWriter *jsonString(JsonWriter *writer, const char *value) {
+    return value != NULL ? jsonStringView(writer, (StringView) {.value = value, .length = strlen(value)}) : NULL;
+}
+
+JsonWriter *jsonStringView(JsonWriter *writer, StringView value) {
+    if (value.value == NULL) return NULL;
+    return writeQuoted(beginValue(writer), value.value, value.length);
+}
+
+JsonWriter *jsonBufferString(JsonWriter *writer, BufferString *value) {
+    return value != NULL ? jsonStringView(writer, toStringView(value)) : NULL;
+}
+
+JsonWriter *jsonInt(JsonWriter *writer, int64_t value) {
+    return writeNumber(beginValue(writer), INT64_TO_STRING(value));
+}
+
+JsonWriter *jsonUInt(JsonWriter *writer, uint64_t value) {
+    return writeNumber(beginValue(writer), UINT64_TO_STRING(value));
+}
+
+JsonWriter *jsonBool(JsonWriter *writer, bool value) {
+    return value ? writeChars(beginValue(writer), "true", 4) : writeChars(beginValue(writer), "false", 5);
+}
+
+JsonWriter *jsonNull(JsonWriter *writer) {
+    return writeChars(beginValue(writer), "null", 4);
+}
+
+JsonWriter *jsonRaw(JsonWriter *writer, const char *json, uint32_t length) {
+    return json != NULL ? writeChars(beginValue(writer), json, length) : NULL;
+}
+
+#ifdef ENABLE_FLOAT_FORMATTING
+JsonWriter *jsonDouble(JsonWriter *writer, double value, int32_t precision) {
+    if (value != value || (value - value) != 0) {   // NaN or infinity, not supported by JSON
+        return jsonNull(writer);
+    }
+    return writeNumber(beginValue(writer), STRING_FORMAT(NUMBER_BUFFER_SIZE, "%.*f", precision, value));
+}
+#endif
+
+bool isJsonWriterComplete(JsonWriter *writer) {
+    return writer != NULL && writer->isRootWritten && writer->depth == 0;
+}
+
+static JsonWriter *beginContainer(JsonWriter *writer, char openChar, uint8_t levelType) {
+    if (writer == NULL || writer->depth >= JSON_WRITER_MAX_DEPTH) return NULL;
+    writer = writeChars(beginValue(writer), &openChar, 1);
+    if (writer != NULL) {
+        writer->levels[writer->depth++] = levelType;
+    }
+    return writer;
+}
+
+static JsonWriter *endContainer(JsonWriter *writer, char closeChar, uint8_t levelType) {
+    if (writer == NULL || writer->depth == 0 || writer->isKeyWritten ||
+        (writer->levels[writer->depth - 1] & ARRAY_LEVEL) != levelType) {
+        return NULL;
+    }
+    writer->depth--;
+    return writeChars(writer, &closeChar, 1);
+}
+
+// writes comma when needed and checks that value is allowed here
+static JsonWriter *beginValue(JsonWriter *writer) {
+    if (writer == NULL) return NULL;
+    if (writer->depth == 0) {
+        if (writer->isRootWritten) return NULL;     // only one root value
+        writer->isRootWritten = true;
+        return writer;
+    }
+
+    uint8_t *level = &writer->levels[writer->depth - 1];
+    if ((*level & ARRAY_LEVEL) == 0) {  // object value should follow the key
+        if (!writer->isKeyWritten) return NULL;
+        writer->isKeyWritten = false;
+        return writer;
+    }
+
+    bool isCommaNeeded = (*level & HAS_VALUES_LEVEL) != 0;
+    *level |= HAS_VALUES_LEVEL;
+    return isCommaNeeded ? writeChars(writer, ",", 1) : writer;
+}
+
+static JsonWriter *writeChars(JsonWriter *writer, const char *chars, uint32_t length) {
+    if (writer == NULL) return NULL;
+    if (writer->sink != NULL) {
+        return sinkChars(writer->sink, chars, length) != NULL ? writer : NULL;
+    }
+    return concatCharsByLength(writer->str, chars, length) != NULL ? writer : NULL;
+}
+
+static JsonWriter *writeQuoted(JsonWriter *writer, const char *value, uint32_t length) {
+    writer = writeChars(writer, "\"", 1);
+    writer = writeEscaped(writer, value, length);
+    return writeChars(writer, "\"", 1);
+}
+
+static JsonWriter *writeEscaped(JsonWriter *writer, const char *value, uint32_t length) {
+    if (writer == NULL) return NULL;
+    if (concatJsonEscaped(writer->str, value, length, false) != NULL) return writer;
+    if (writer->sink == NULL || flushStringSink(writer->sink) == NULL) return NULL;
+    if (concatJsonEscaped(writer->str, value, length, false) != NULL) return writer;
+
+    // longer than sink buffer, escape by parts that fit into the buffer even when every char is escaped
+    uint32_t partLength = (writer->str->capacity - 1) / MAX_ESCAPED_CHAR_LENGTH;
+    if (partLength == 0) return NULL;
+    for (uint32_t offset = 0; offset < length; offset += partLength) {
+        const char *part = value + offset;
+        uint32_t escapeLength = (length - offset < partLength) ? length - offset : partLength;
+        if (concatJsonEscaped(writer->str, part, escapeLength, false) != NULL) continue;
+        if (flushStringSink(writer->sink) == NULL || concatJsonEscaped(writer->str, part, escapeLength, false) == NULL) {
+            return NULL;
+        }
+    }
+    return writer;
+}
+
+static JsonWriter *writeNumber(JsonWriter *writer, BufferString *number) {
+    return number != NULL ? writeChars(writer, number->value, number->length) : NULL;
+}
@@ -0,0 +1,62 @@
+#include "MappedString.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+BufferString *mapFileToString(MappedString *mapped, const char *path) {
+    if (mapped == NULL || path == NULL) return NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size >= UINT32_MAX) {   // pipes and devices have no size
+        close(fd);
+        return NULL;
+    }
+
+    char probe;
+    if (fileStat.st_size == 0 && read(fd, &probe, 1) != 0) {    // procfs and sysfs files report zero size, but have content
+        close(fd);
+        return NULL;
+    }
+
+    size_t fileLength = fileStat.st_size;
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t mappedLength = (fileLength / pageSize + 1) * pageSize;   // reserve zero filled space after content for null terminator
+    char *region = mmap(NULL, mappedLength, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    if (fileLength > 0 && mmap(region, fileLength, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(region, mappedLength);
+        close(fd);
+        return NULL;
+    }
+    close(fd);  // mapping is kept after close
+
+    // terminator page is writable, so functions that only rewrite terminator don't crash. Private mapping, file is not changed
+    size_t terminatorPage = (fileLength / pageSize) * pageSize;
+    if (mprotect(region + terminatorPage, pageSize, PROT_READ | PROT_WRITE) != 0) {
+        munmap(region, mappedLength);
+        return NULL;
+    }
+    posix_madvise(region, mappedLength, POSIX_MADV_SEQUENTIAL);
+
+    mapped->mappedLength = mappedLength;
+    mapped->str.value = region;
+    mapped->str.length = fileLength;
+    mapped->str.capacity = fileLength + 1;  // no free space, so concat functions fail before writing past the terminator
+    mapped->str.hash = 0;
+    return &mapped->str;
+}
+
+void unmapFileString(MappedString *mapped) {
+    if (mapped == NULL || mapped->str.value == NULL) return;
+    munmap(mapped->str.value, mapped->mappedLength);
+    memset(mapped, 0, sizeof(MappedString));
+}
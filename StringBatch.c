@@ -0,0 +1,275 @@
+#include "StringBatch.h"
+
+#ifdef ENABLE_MULTITHREADING
+
+#define MIN_CHUNK_SIZE 16
+#define CHUNKS_PER_THREAD 8     // enough chunks to balance uneven work
+#define MIN_SEARCH_CHUNK_SIZE 65536
+#define MAX_SEARCH_CHUNKS 256
+#define NOT_FOUND_OFFSET UINT32_MAX
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+struct StringBatchJob {
+    BufferString **strings;
+    uint32_t count;
+    StringBatchTask task;
+    StringBatchOperation operation;
+    void *context;
+    BufferString **results;
+    uint32_t chunkSize;
+    uint32_t nextIndex;
+    uint32_t failedCount;
+};
+
+typedef struct ParallelSearch {
+    const char *value;
+    uint32_t length;
+    const char *needle;
+    uint32_t needleLength;
+    uint32_t chunkSize;
+    uint32_t firstOffset;
+    uint32_t chunkCounts[MAX_SEARCH_CHUNKS];
+    uint32_t *offsets;
+    uint32_t capacity;
+} ParallelSearch;
+
+static uint32_t runBatchJob(StringBatchPool *pool, StringBatchJob *job);
+static void *runBatchWorker(void *argument);
+static void processBatchJob(StringBatchJob *job);
+static uint32_t initParallelSearch(ParallelSearch *search, BufferString *str, const char *stringToFind);
+static void searchFirstInChunk(uint32_t index, void *context);
+static void countMatchesInChunk(uint32_t index, void *context);
+static void storeMatchesInChunk(uint32_t index, void *context);
+static const char *findInRange(const char *start, const char *end, const char *needle, uint32_t needleLength);
+
+
+StringBatchPool *newStringBatchPool(StringBatchPool *pool, pthread_t *threads, uint32_t threadCount) {
+    if (pool == NULL || threads == NULL) return NULL;
+    pool->threads = threads;
+    pool->threadCount = 0;
+    pool->job = NULL;
+    pool->jobGeneration = 0;
+    pool->activeWorkers = 0;
+    pool->isStopping = false;
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) return NULL;
+    pthread_cond_init(&pool->jobReady, NULL);
+    pthread_cond_init(&pool->jobDone, NULL);
+
+    for (uint32_t i = 0; i < threadCount; i++) {
+        if (pthread_create(&pool->threads[i], NULL, runBatchWorker, pool) != 0) {
+            stopStringBatchPool(pool);
+            return NULL;
+        }
+        pool->threadCount++;
+    }
+    return pool;
+}
+
+StringBatchPool *stopStringBatchPool(StringBatchPool *pool) {
+    if (pool == NULL) return NULL;
+    pthread_mutex_lock(&pool->lock);
+    pool->isStopping = true;
+    pthread_cond_broadcast(&pool->jobReady);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint32_t i = 0; i < pool->threadCount; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->threadCount = 0;
+    pthread_cond_destroy(&pool->jobReady);
+    pthread_cond_destroy(&pool->jobDone);
+    pthread_mutex_destroy(&pool->lock);
+    return pool;
+}
+
+uint32_t runStringBatch(StringBatchPool *pool, BufferString **strings, uint32_t count,
+                        StringBatchOperation operation, void *context, BufferString **results) {
+    if (pool == NULL || strings == NULL || operation == NULL) return count;
+    uint32_t chunkSize = count / ((pool->threadCount + 1) * CHUNKS_PER_THREAD);
+    StringBatchJob job = {
+            .strings = strings,
+            .count = count,
+            .operation = operation,
+            .context = context,
+            .results = results,
+            .chunkSize = (chunkSize > MIN_CHUNK_SIZE) ? chunkSize : MIN_CHUNK_SIZE,
+            .nextIndex = 0,
+            .failedCount = 0,
+    };
+    return runBatchJob(pool, &job);
+}
+
+void runStringBatchTasks(StringBatchPool *pool, uint32_t count, StringBatchTask task, void *context) {
+    if (pool == NULL || task == NULL) return;
+    StringBatchJob job = {
+            .count = count,
+            .task = task,
+            .context = context,
+            .chunkSize = 1,     // tasks are expected to be large
+    };
+    runBatchJob(pool, &job);
+}
+
+int32_t parallelIndexOfString(StringBatchPool *pool, BufferString *str, const char *stringToFind) {
+    ParallelSearch search;
+    uint32_t chunkCount = initParallelSearch(&search, str, stringToFind);
+    if (pool == NULL || chunkCount == 0) return -1;
+    runStringBatchTasks(pool, chunkCount, searchFirstInChunk, &search);
+    return search.firstOffset != NOT_FOUND_OFFSET ? (int32_t) search.firstOffset : -1;
+}
+
+uint32_t parallelFindAllStrings(StringBatchPool *pool, BufferString *str, const char *stringToFind, uint32_t *offsets, uint32_t capacity) {
+    ParallelSearch search;
+    uint32_t chunkCount = initParallelSearch(&search, str, stringToFind);
+    if (pool == NULL || chunkCount == 0 || (offsets == NULL && capacity > 0)) return 0;
+    runStringBatchTasks(pool, chunkCount, countMatchesInChunk, &search);
+
+    uint32_t totalCount = 0;
+    for (uint32_t i = 0; i < chunkCount; i++) {    // chunk counts to chunk start positions in offsets
+        uint32_t matchCount = search.chunkCounts[i];
+        search.chunkCounts[i] = totalCount;
+        totalCount += matchCount;
+    }
+
+    search.offsets = offsets;
+    search.capacity = capacity;
+    if (capacity > 0) {
+        runStringBatchTasks(pool, chunkCount, storeMatchesInChunk, &search);
+    }
+    return totalCount;
+}
+
+static uint32_t runBatchJob(StringBatchPool *pool, StringBatchJob *job) {
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->activeWorkers = pool->threadCount;
+    pool->jobGeneration++;
+    pthread_cond_broadcast(&pool->jobReady);
+    pthread_mutex_unlock(&pool->lock);
+
+    processBatchJob(job);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->activeWorkers > 0) {
+        pthread_cond_wait(&pool->jobDone, &pool->lock);
+    }
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    return job->failedCount;
+}
+
+static void *runBatchWorker(void *argument) {
+    StringBatchPool *pool = argument;
+    uint32_t seenGeneration = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->isStopping && pool->jobGeneration == seenGeneration) {
+            pthread_cond_wait(&pool->jobReady, &pool->lock);
+        }
+        if (pool->isStopping) break;
+
+        seenGeneration = pool->jobGeneration;
+        StringBatchJob *job = pool->job;
+        pthread_mutex_unlock(&pool->lock);
+
+        processBatchJob(job);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->activeWorkers == 0) {
+            pthread_cond_signal(&pool->jobDone);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void processBatchJob(StringBatchJob *job) {
+    uint32_t failedCount = 0;
+    while (true) {
+        uint32_t start = __atomic_fetch_add(&job->nextIndex, job->chunkSize, __ATOMIC_RELAXED);
+        if (start >= job->count) break;
+        uint32_t end = (job->count - start > job->chunkSize) ? start + job->chunkSize : job->count;
+
+        for (uint32_t i = start; i < end; i++) {
+            if (job->task != NULL) {
+                job->task(i, job->context);
+                continue;
+            }
+            BufferString *result = job->operation(job->strings[i], i, job->context);
+            if (job->results != NULL) {
+                job->results[i] = result;
+            }
+            failedCount += (result == NULL);
+        }
+    }
+    __atomic_fetch_add(&job->failedCount, failedCount, __ATOMIC_RELAXED);
+}
+
+static uint32_t initParallelSearch(ParallelSearch *search, BufferString *str, const char *stringToFind) {
+    if (str == NULL || stringToFind == NULL) return 0;
+    search->value = str->value;
+    search->length = str->length;
+    search->needle = stringToFind;
+    search->needleLength = strlen(stringToFind);
+    search->firstOffset = NOT_FOUND_OFFSET;
+    search->offsets = NULL;
+    search->capacity = 0;
+    if (search->needleLength == 0 || search->needleLength > search->length) return 0;
+
+    uint32_t chunkCount = (search->length + MIN_SEARCH_CHUNK_SIZE - 1) / MIN_SEARCH_CHUNK_SIZE;
+    chunkCount = (chunkCount < MAX_SEARCH_CHUNKS) ? chunkCount : MAX_SEARCH_CHUNKS;
+    search->chunkSize = (search->length + chunkCount - 1) / chunkCount;
+    return (search->length + search->chunkSize - 1) / search->chunkSize;
+}
+
+// match start positions of the chunk, match itself can continue in the next chunk
+#define CHUNK_START(search, index) ((search)->value + (index) * (search)->chunkSize)
+#define CHUNK_END(search, index) ((search)->value + MIN((index + 1) * (search)->chunkSize, (search)->length - (search)->needleLength + 1))
+
+static void searchFirstInChunk(uint32_t index, void *context) {
+    ParallelSearch *search = context;
+    uint32_t chunkStart = index * search->chunkSize;
+    if (chunkStart > __atomic_load_n(&search->firstOffset, __ATOMIC_RELAXED)) return;    // match is already found before this chunk
+
+    const char *match = findInRange(CHUNK_START(search, index), CHUNK_END(search, index), search->needle, search->needleLength);
+    if (match == NULL) return;
+
+    uint32_t offset = match - search->value;
+    uint32_t firstOffset = __atomic_load_n(&search->firstOffset, __ATOMIC_RELAXED);
+    while (offset < firstOffset &&
+           !__atomic_compare_exchange_n(&search->firstOffset, &firstOffset, offset, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+static void countMatchesInChunk(uint32_t index, void *context) {
+    ParallelSearch *search = context;
+    const char *end = CHUNK_END(search, index);
+    uint32_t count = 0;
+    for (const char *match = CHUNK_START(search, index);
+         (match = findInRange(match, end, search->needle, search->needleLength)) != NULL; match++) {
+        count++;
+    }
+    search->chunkCounts[index] = count;
+}
+
+static void storeMatchesInChunk(uint32_t index, void *context) {
+    ParallelSearch *search = context;
+    const char *end = CHUNK_END(search, index);
+    uint32_t position = search->chunkCounts[index];
+    for (const char *match = CHUNK_START(search, index); position < search->capacity &&
+         (match = findInRange(match, end, search->needle, search->needleLength)) != NULL; match++) {
+        search->offsets[position++] = match - search->value;
+    }
+}
+
+static const char *findInRange(const char *start, const char *end, const char *needle, uint32_t needleLength) {
+    while (start < end && (start = memchr(start, needle[0], end - start)) != NULL) {
+        if (memcmp(start, needle, needleLength) == 0) {
+            return start;
+        }
+        start++;
+    }
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include "StringIntern.h"
+
+#define EMPTY_VIEW ((StringView) {0})
+
+
+StringInternTable *newStringInternTable(StringInternTable *table, char *arena, uint32_t arenaCapacity, StringMapEntry *entries, uint32_t entryCapacity) {
+    if (table == NULL || arena == NULL || newStringMap(&table->index, entries, entryCapacity) == NULL) return NULL;
+    table->arena = arena;
+    table->arenaCapacity = arenaCapacity;
+    table->arenaLength = 0;
+    return table;
+}
+
+StringInternTable *clearStringInternTable(StringInternTable *table) {
+    if (table == NULL) return NULL;
+    clearStringMap(&table->index);
+    table->arenaLength = 0;
+    return table;
+}
+
+StringView internView(StringInternTable *table, StringView str) {
+    if (table == NULL || str.value == NULL) return EMPTY_VIEW;
+    StringView interned = findInterned(table, str);
+    if (interned.value != NULL) {
+        return interned;
+    }
+
+    if (str.length >= (table->arenaCapacity - table->arenaLength)) return EMPTY_VIEW;  // also reserve space for null terminator
+    char *arenaPointer = table->arena + table->arenaLength;
+    memcpy(arenaPointer, str.value, str.length);
+    arenaPointer[str.length] = '\0';
+
+    interned.value = arenaPointer;
+    interned.length = str.length;
+    if (stringMapPut(&table->index, interned, arenaPointer) == NULL) {
+        return EMPTY_VIEW;  // index is full, arena space is not claimed
+    }
+    table->arenaLength += str.length + 1;
+    return interned;
+}
+
+StringView internString(StringInternTable *table, BufferString *str) {
+    if (table == NULL || str == NULL) return EMPTY_VIEW;
+    const char *value = stringMapGetString(&table->index, str);    // fast path with cached string hash
+    return value != NULL ? (StringView) {.value = value, .length = str->length} : internView(table, toStringView(str));
+}
+
+StringView internCStr(StringInternTable *table, const char *str) {
+    return str != NULL ? internView(table, (StringView) {.value = str, .length = strlen(str)}) : EMPTY_VIEW;
+}
+
+StringView findInterned(StringInternTable *table, StringView str) {
+    if (table == NULL || str.value == NULL) return EMPTY_VIEW;
+    const char *value = stringMapGet(&table->index, str);
+    return value != NULL ? (StringView) {.value = value, .length = str.length} : EMPTY_VIEW;
+}
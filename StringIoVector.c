@@ -0,0 +1,96 @@
+#include "StringIoVector.h"
+
+#ifndef IOV_MAX
+#define IOV_MAX 16  // minimal value required by POSIX
+#endif
+
+static inline int pendingVectorCount(StringIoVector *ioVector);
+static ssize_t advanceIoVector(StringIoVector *ioVector, ssize_t writtenLength);
+
+
+StringIoVector *newStringIoVector(StringIoVector *ioVector, struct iovec *vectors, uint32_t capacity) {
+    if (ioVector == NULL || vectors == NULL || capacity == 0) return NULL;
+    ioVector->vectors = vectors;
+    ioVector->capacity = capacity;
+    return clearStringIoVector(ioVector);
+}
+
+StringIoVector *clearStringIoVector(StringIoVector *ioVector) {
+    if (ioVector == NULL) return NULL;
+    ioVector->count = 0;
+    ioVector->index = 0;
+    ioVector->remainingLength = 0;
+    return ioVector;
+}
+
+StringIoVector *addIoVectorChars(StringIoVector *ioVector, const char *data, uint32_t length) {
+    if (ioVector == NULL || data == NULL || ioVector->count >= ioVector->capacity) return NULL;
+    if (length == 0) return ioVector;   // empty parts are not needed
+    struct iovec *vector = &ioVector->vectors[ioVector->count++];
+    vector->iov_base = (void *) data;
+    vector->iov_len = length;
+    ioVector->remainingLength += length;
+    return ioVector;
+}
+
+StringIoVector *addIoVectorString(StringIoVector *ioVector, BufferString *str) {
+    return str != NULL ? addIoVectorChars(ioVector, str->value, str->length) : NULL;
+}
+
+StringIoVector *addIoVectorView(StringIoVector *ioVector, StringView view) {
+    return addIoVectorChars(ioVector, view.value, view.length);
+}
+
+StringIoVector *addIoVectorCStr(StringIoVector *ioVector, const char *str) {
+    return str != NULL ? addIoVectorChars(ioVector, str, strlen(str)) : NULL;
+}
+
+ssize_t writeStringIoVector(StringIoVector *ioVector, int fd) {
+    if (ioVector == NULL) return -1;
+    if (isStringIoVectorDone(ioVector)) return 0;
+    ssize_t writtenLength = writev(fd, &ioVector->vectors[ioVector->index], pendingVectorCount(ioVector));
+    return advanceIoVector(ioVector, writtenLength);
+}
+
+ssize_t sendStringIoVector(StringIoVector *ioVector, int socket, int flags) {
+    if (ioVector == NULL) return -1;
+    if (isStringIoVectorDone(ioVector)) return 0;
+    struct msghdr message = {
+            .msg_iov = &ioVector->vectors[ioVector->index],
+            .msg_iovlen = pendingVectorCount(ioVector)
+    };
+    ssize_t writtenLength = sendmsg(socket, &message, flags);
+    return advanceIoVector(ioVector, writtenLength);
+}
+
+StringIoVector *writeAllStringIoVector(StringIoVector *ioVector, int fd) {
+    while (!isStringIoVectorDone(ioVector)) {
+        if (writeStringIoVector(ioVector, fd) < 0 && errno != EINTR) {
+            return NULL;    // nothing lost, write can be resumed later, for example on EAGAIN
+        }
+    }
+    return ioVector;
+}
+
+static inline int pendingVectorCount(StringIoVector *ioVector) {
+    uint32_t count = ioVector->count - ioVector->index;
+    return (int) ((count < IOV_MAX) ? count : IOV_MAX);
+}
+
+static ssize_t advanceIoVector(StringIoVector *ioVector, ssize_t writtenLength) {
+    if (writtenLength <= 0) return writtenLength;
+    ioVector->remainingLength -= writtenLength;
+
+    size_t length = writtenLength;
+    while (length > 0) {
+        struct iovec *vector = &ioVector->vectors[ioVector->index];
+        if (length < vector->iov_len) {    // partially written, continue from the rest
+            vector->iov_base = (char *) vector->iov_base + length;
+            vector->iov_len -= length;
+            break;
+        }
+        length -= vector->iov_len;
+        ioVector->index++;
+    }
+    return writtenLength;
+}
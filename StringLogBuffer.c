@@ -0,0 +1,150 @@
+#include "StringLogBuffer.h"
+
+#ifdef ENABLE_MULTITHREADING
+#include <time.h>
+#endif
+
+#define RECORD_HEADER_SIZE sizeof(uint32_t)
+#define RECORD_ALIGNMENT 4
+#define EMPTY_HEADER 0                      // claimed, but record is not copied yet
+#define COMMITTED_FLAG 0x80000000U
+#define WRAP_MARKER UINT32_MAX              // record did not fit at the end, continue from the buffer start
+#define RECORD_SIZE(length) ((RECORD_HEADER_SIZE + (length) + (RECORD_ALIGNMENT - 1)) & ~(RECORD_ALIGNMENT - 1))
+#define IS_POWER_OF_TWO(value) ((value) != 0 && ((value) & ((value) - 1)) == 0)
+
+#define LOAD_ACQUIRE(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+
+static inline uint32_t *recordHeader(StringLogBuffer *log, uint32_t offset);
+
+
+StringLogBuffer *newStringLogBuffer(StringLogBuffer *log, void *buffer, uint32_t capacity) {
+    if (log == NULL || buffer == NULL || !IS_POWER_OF_TWO(capacity) ||
+        capacity < RECORD_SIZE(1) || capacity > COMMITTED_FLAG || ((uintptr_t) buffer % RECORD_ALIGNMENT) != 0) {
+        return NULL;
+    }
+    memset(buffer, 0, capacity);    // all not claimed space should have empty headers
+    log->buffer = buffer;
+    log->capacity = capacity;
+    log->reserved = 0;
+    log->tail = 0;
+    log->droppedCount = 0;
+    return log;
+}
+
+StringLogBuffer *appendLogChars(StringLogBuffer *log, const char *record, uint32_t length) {
+    if (log == NULL || record == NULL || length >= log->capacity) return NULL;
+    uint32_t recordSize = RECORD_SIZE(length);
+    uint32_t mask = log->capacity - 1;
+    uint32_t position = __atomic_load_n(&log->reserved, __ATOMIC_RELAXED);
+    uint32_t offset;
+    uint32_t claimSize;
+
+    do {
+        offset = position & mask;
+        uint32_t endSpace = log->capacity - offset;
+        claimSize = (recordSize <= endSpace) ? recordSize : endSpace + recordSize;  // skip the end part, if record does not fit
+        uint32_t tail = LOAD_ACQUIRE(&log->tail);
+        if (position + claimSize - tail > log->capacity) {
+            __atomic_fetch_add(&log->droppedCount, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&log->reserved, &position, position + claimSize,
+                                          true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if (claimSize != recordSize) {
+        STORE_RELEASE(recordHeader(log, offset), WRAP_MARKER);
+        offset = 0;
+    }
+    memcpy(log->buffer + offset + RECORD_HEADER_SIZE, record, length);
+    STORE_RELEASE(recordHeader(log, offset), length | COMMITTED_FLAG);  // publish record for consumer
+    return log;
+}
+
+StringLogBuffer *appendLogString(StringLogBuffer *log, BufferString *record) {
+    return record != NULL ? appendLogChars(log, record->value, record->length) : NULL;
+}
+
+uint32_t drainStringLog(StringLogBuffer *log, StringRingConsumer consumer, void *context, uint32_t maxCount) {
+    if (log == NULL || consumer == NULL) return 0;
+    uint32_t mask = log->capacity - 1;
+    uint32_t tail = log->tail;
+    uint32_t reserved = LOAD_ACQUIRE(&log->reserved);
+    uint32_t count = 0;
+
+    while (tail != reserved && count < maxCount) {
+        uint32_t offset = tail & mask;
+        uint32_t header = LOAD_ACQUIRE(recordHeader(log, offset));
+        if (header == EMPTY_HEADER) break;  // producer is still copying, keep order of records
+
+        if (header == WRAP_MARKER) {
+            *recordHeader(log, offset) = EMPTY_HEADER;
+            tail += log->capacity - offset;
+            continue;
+        }
+
+        uint32_t length = header & ~COMMITTED_FLAG;
+        StringView record = {.value = log->buffer + offset + RECORD_HEADER_SIZE, .length = length};
+        if (!consumer(record, context)) {
+            break;
+        }
+        uint32_t recordSize = RECORD_SIZE(length);
+        memset(log->buffer + offset, 0, recordSize);  // record data may be in place of the next record headers
+        tail += recordSize;
+        count++;
+    }
+
+    STORE_RELEASE(&log->tail, tail);
+    return count;
+}
+
+bool isStringLogEmpty(StringLogBuffer *log) {
+    return log == NULL || LOAD_ACQUIRE(&log->reserved) == LOAD_ACQUIRE(&log->tail);
+}
+
+uint32_t stringLogDroppedCount(StringLogBuffer *log) {
+    return log != NULL ? __atomic_load_n(&log->droppedCount, __ATOMIC_RELAXED) : 0;
+}
+
+static inline uint32_t *recordHeader(StringLogBuffer *log, uint32_t offset) {
+    return (uint32_t *) (log->buffer + offset);
+}
+
+#ifdef ENABLE_MULTITHREADING
+static void *runStringLogFlusher(void *argument);
+static void sleepMillis(uint32_t millis);
+
+StringLogFlusher *startStringLogFlusher(StringLogFlusher *flusher, StringLogBuffer *log,
+                                        StringRingConsumer consumer, void *context, uint32_t intervalMs) {
+    if (flusher == NULL || log == NULL || consumer == NULL) return NULL;
+    flusher->log = log;
+    flusher->consumer = consumer;
+    flusher->context = context;
+    flusher->intervalMs = intervalMs;
+    flusher->isRunning = true;
+    return pthread_create(&flusher->thread, NULL, runStringLogFlusher, flusher) == 0 ? flusher : NULL;
+}
+
+StringLogFlusher *stopStringLogFlusher(StringLogFlusher *flusher) {
+    if (flusher == NULL) return NULL;
+    STORE_RELEASE(&flusher->isRunning, false);
+    if (pthread_join(flusher->thread, NULL) != 0) return NULL;
+    while (drainStringLog(flusher->log, flusher->consumer, flusher->context, UINT32_MAX) > 0);
+    return flusher;
+}
+
+static void *runStringLogFlusher(void *argument) {
+    StringLogFlusher *flusher = argument;
+    while (LOAD_ACQUIRE(&flusher->isRunning)) {
+        if (drainStringLog(flusher->log, flusher->consumer, flusher->context, UINT32_MAX) == 0) {
+            sleepMillis(flusher->intervalMs);
+        }
+    }
+    return NULL;
+}
+
+static void sleepMillis(uint32_t millis) {
+    struct timespec delay = {.tv_sec = millis / 1000, .tv_nsec = (long) (millis % 1000) * 1000000L};
+    nanosleep(&delay, NULL);
+}
+#endif
@@ -0,0 +1,152 @@
+#include "StringMap.h"
+
+#define EMPTY_SLOT_HASH 0
+#define NOT_FOUND_INDEX UINT32_MAX
+#define IS_POWER_OF_TWO(value) ((value) != 0 && ((value) & ((value) - 1)) == 0)
+#define SLOT_HASH(hash) (((hash) != EMPTY_SLOT_HASH) ? (hash) : 1)     // zero hash is reserved for empty slots
+#define PROBE_DISTANCE(map, hash, index) (((index) - ((hash) & ((map)->capacity - 1))) & ((map)->capacity - 1))
+
+static StringMap *putEntry(StringMap *map, StringView key, uint32_t hash, void *value);
+static void *getEntryValue(StringMap *map, StringView key, uint32_t hash);
+static uint32_t findEntryIndex(StringMap *map, StringView key, uint32_t hash);
+
+
+StringMap *newStringMap(StringMap *map, StringMapEntry *entries, uint32_t capacity) {
+    if (map == NULL || entries == NULL || !IS_POWER_OF_TWO(capacity)) return NULL;
+    map->entries = entries;
+    map->capacity = capacity;
+    return clearStringMap(map);
+}
+
+StringMap *clearStringMap(StringMap *map) {
+    if (map == NULL) return NULL;
+    memset(map->entries, 0, sizeof(StringMapEntry) * map->capacity);
+    map->size = 0;
+    return map;
+}
+
+StringMap *stringMapPut(StringMap *map, StringView key, void *value) {
+    return key.value != NULL ? putEntry(map, key, stringHash(key.value, key.length), value) : NULL;
+}
+
+StringMap *stringMapPutString(StringMap *map, BufferString *key, void *value) {
+    return key != NULL ? putEntry(map, toStringView(key), stringHashCode(key), value) : NULL;
+}
+
+StringMap *stringMapPutCStr(StringMap *map, const char *key, void *value) {
+    return key != NULL ? stringMapPut(map, (StringView) {.value = key, .length = strlen(key)}, value) : NULL;
+}
+
+void *stringMapGet(StringMap *map, StringView key) {
+    return key.value != NULL ? getEntryValue(map, key, stringHash(key.value, key.length)) : NULL;
+}
+
+void *stringMapGetString(StringMap *map, BufferString *key) {
+    return key != NULL ? getEntryValue(map, toStringView(key), stringHashCode(key)) : NULL;
+}
+
+void *stringMapGetCStr(StringMap *map, const char *key) {
+    return key != NULL ? stringMapGet(map, (StringView) {.value = key, .length = strlen(key)}) : NULL;
+}
+
+bool isStringMapContains(StringMap *map, StringView key) {
+    return key.value != NULL && findEntryIndex(map, key, stringHash(key.value, key.length)) != NOT_FOUND_INDEX;
+}
+
+void *stringMapRemove(StringMap *map, StringView key) {
+    if (key.value == NULL) return NULL;
+    uint32_t index = findEntryIndex(map, key, stringHash(key.value, key.length));
+    if (index == NOT_FOUND_INDEX) return NULL;
+
+    void *value = map->entries[index].value;
+    uint32_t mask = map->capacity - 1;
+    uint32_t nextIndex = (index + 1) & mask;
+    while (map->entries[nextIndex].hash != EMPTY_SLOT_HASH &&
+           PROBE_DISTANCE(map, map->entries[nextIndex].hash, nextIndex) > 0) {  // backward shift deletion, no tombstones needed
+        map->entries[index] = map->entries[nextIndex];
+        index = nextIndex;
+        nextIndex = (nextIndex + 1) & mask;
+    }
+
+    memset(&map->entries[index], 0, sizeof(StringMapEntry));
+    map->size--;
+    return value;
+}
+
+StringMapIterator getStringMapIterator(StringMap *map) {
+    StringMapIterator iterator = {
+            .map = map,
+            .index = 0,
+    };
+    return iterator;
+}
+
+bool hasNextMapEntry(StringMapIterator *iterator) {
+    if (iterator == NULL || iterator->map == NULL) return false;
+    while (iterator->index < iterator->map->capacity) {
+        StringMapEntry *entry = &iterator->map->entries[iterator->index++];
+        if (entry->hash != EMPTY_SLOT_HASH) {
+            iterator->key = entry->key;
+            iterator->value = entry->value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static StringMap *putEntry(StringMap *map, StringView key, uint32_t hash, void *value) {
+    if (map == NULL) return NULL;
+    hash = SLOT_HASH(hash);
+    uint32_t index = findEntryIndex(map, key, hash);
+    if (index != NOT_FOUND_INDEX) {   // key already exist, replace value
+        map->entries[index].value = value;
+        return map;
+    }
+
+    if (map->size >= map->capacity) return NULL;
+    StringMapEntry newEntry = {.key = key, .value = value, .hash = hash};
+    uint32_t mask = map->capacity - 1;
+    uint32_t distance = 0;
+    index = hash & mask;
+
+    while (map->entries[index].hash != EMPTY_SLOT_HASH) {
+        uint32_t slotDistance = PROBE_DISTANCE(map, map->entries[index].hash, index);
+        if (slotDistance < distance) {  // take slot from the entry that is closer to its home position
+            StringMapEntry swapEntry = map->entries[index];
+            map->entries[index] = newEntry;
+            newEntry = swapEntry;
+            distance = slotDistance;
+        }
+        index = (index + 1) & mask;
+        distance++;
+    }
+
+    map->entries[index] = newEntry;
+    map->size++;
+    return map;
+}
+
+static void *getEntryValue(StringMap *map, StringView key, uint32_t hash) {
+    uint32_t index = findEntryIndex(map, key, SLOT_HASH(hash));
+    return index != NOT_FOUND_INDEX ? map->entries[index].value : NULL;
+}
+
+static uint32_t findEntryIndex(StringMap *map, StringView key, uint32_t hash) {
+    if (map == NULL) return NOT_FOUND_INDEX;
+    hash = SLOT_HASH(hash);
+    uint32_t mask = map->capacity - 1;
+    uint32_t index = hash & mask;
+
+    for (uint32_t distance = 0; distance < map->capacity; distance++) {
+        StringMapEntry *entry = &map->entries[index];
+        if (entry->hash == EMPTY_SLOT_HASH || PROBE_DISTANCE(map, entry->hash, index) < distance) {
+            return NOT_FOUND_INDEX; // key would have been placed here, so it is not in the map
+        }
+
+        if (entry->hash == hash && entry->key.length == key.length && memcmp(entry->key.value, key.value, key.length) == 0) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return NOT_FOUND_INDEX;
+}
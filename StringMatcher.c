@@ -0,0 +1,180 @@
+#include "StringMatcher.h"
+
+#define ROOT_NODE 0
+#define NO_NODE 0   // root is never a child or pattern end, so it can mark empty links
+#define NO_PATTERN UINT16_MAX
+
+static uint16_t findChildNode(StringMatcher *matcher, uint16_t node, char symbol);
+static uint16_t nextState(StringMatcher *matcher, uint16_t state, char symbol);
+static void linkChildNodes(StringMatcher *matcher, uint16_t parent);
+
+
+StringMatcher *newStringMatcher(StringMatcher *matcher, StringMatcherNode *nodes, uint16_t nodeCapacity) {
+    if (matcher == NULL || nodes == NULL || nodeCapacity == 0) return NULL;
+    matcher->nodes = nodes;
+    matcher->nodeCapacity = nodeCapacity;
+    matcher->nodeCount = 1;
+    matcher->patternCount = 0;
+    matcher->isCompiled = false;
+    memset(&nodes[ROOT_NODE], 0, sizeof(StringMatcherNode));
+    nodes[ROOT_NODE].patternId = NO_PATTERN;
+    return resetStringMatcher(matcher);
+}
+
+StringMatcher *addMatcherPattern(StringMatcher *matcher, const char *pattern) {
+    return pattern != NULL ? addMatcherPatternByLength(matcher, pattern, strlen(pattern)) : NULL;
+}
+
+StringMatcher *addMatcherPatternByLength(StringMatcher *matcher, const char *pattern, uint32_t length) {
+    if (matcher == NULL || pattern == NULL || length == 0 || matcher->patternCount >= NO_PATTERN) return NULL;
+
+    uint16_t node = ROOT_NODE;
+    uint32_t existingLength = 0;
+    while (existingLength < length) {  // follow already existing prefix
+        uint16_t child = findChildNode(matcher, node, pattern[existingLength]);
+        if (child == NO_NODE) break;
+        node = child;
+        existingLength++;
+    }
+
+    if ((length - existingLength) > (uint32_t) (matcher->nodeCapacity - matcher->nodeCount)) return NULL;   // check before any modification
+    if (existingLength == length && matcher->nodes[node].patternId != NO_PATTERN) return NULL;
+
+    for (uint32_t i = existingLength; i < length; i++) {
+        uint16_t child = matcher->nodes[node].firstChild;
+        uint16_t newNode = matcher->nodeCount++;
+        StringMatcherNode *nodePointer = &matcher->nodes[newNode];
+        memset(nodePointer, 0, sizeof(StringMatcherNode));
+        nodePointer->symbol = pattern[i];
+        nodePointer->depth = i + 1;
+        nodePointer->patternId = NO_PATTERN;
+        nodePointer->nextSibling = child;
+        matcher->nodes[node].firstChild = newNode;
+        node = newNode;
+    }
+
+    matcher->nodes[node].patternId = matcher->patternCount++;
+    matcher->isCompiled = false;
+    return matcher;
+}
+
+StringMatcher *compileStringMatcher(StringMatcher *matcher) {
+    if (matcher == NULL) return NULL;
+    uint16_t maxDepth = 0;
+    for (uint16_t i = 0; i < matcher->nodeCount; i++) {
+        maxDepth = (matcher->nodes[i].depth > maxDepth) ? matcher->nodes[i].depth : maxDepth;
+    }
+
+    // breadth first by depth levels, so fail node of every child is always linked before. No queue memory needed
+    for (uint16_t depth = 0; depth < maxDepth; depth++) {
+        for (uint16_t i = 0; i < matcher->nodeCount; i++) {
+            if (matcher->nodes[i].depth == depth) {
+                linkChildNodes(matcher, i);
+            }
+        }
+    }
+
+    matcher->isCompiled = true;
+    return resetStringMatcher(matcher);
+}
+
+bool findFirstMatch(StringMatcher *matcher, BufferString *str, StringMatch *match) {
+    if (matcher == NULL || !matcher->isCompiled || str == NULL || match == NULL) return false;
+    uint16_t state = ROOT_NODE;
+    bool isFound = false;
+    for (uint32_t i = 0; i < str->length; i++) {
+        state = nextState(matcher, state, str->value[i]);
+        uint32_t end = i + 1;
+        if (isFound && end - matcher->nodes[state].depth > match->offset) break;   // no pattern in progress starts earlier
+
+        uint16_t outputNode = (matcher->nodes[state].patternId != NO_PATTERN) ? state : matcher->nodes[state].dictionaryLink;
+        if (outputNode != NO_NODE) {    // the longest pattern ending here starts the earliest
+            StringMatcherNode *node = &matcher->nodes[outputNode];
+            if (!isFound || end - node->depth <= match->offset) {  // same start and later end is longer match
+                match->patternId = node->patternId;
+                match->length = node->depth;
+                match->offset = end - node->depth;
+                isFound = true;
+            }
+        }
+    }
+    return isFound;
+}
+
+StringMatchIterator getStringMatchIterator(StringMatcher *matcher, const char *chunk, uint32_t length) {
+    StringMatchIterator iterator = {
+            .matcher = matcher,
+            .text = chunk,
+            .length = (chunk != NULL) ? length : 0,
+            .position = 0,
+            .outputNode = NO_NODE
+    };
+    return iterator;
+}
+
+bool hasNextMatch(StringMatchIterator *iterator) {
+    if (iterator == NULL || iterator->matcher == NULL || !iterator->matcher->isCompiled) return false;
+    StringMatcher *matcher = iterator->matcher;
+
+    while (true) {
+        while (iterator->outputNode != NO_NODE) {  // report current state and all shorter patterns that end at the same position
+            StringMatcherNode *node = &matcher->nodes[iterator->outputNode];
+            iterator->outputNode = node->dictionaryLink;
+            if (node->patternId != NO_PATTERN) {
+                iterator->match.patternId = node->patternId;
+                iterator->match.length = node->depth;
+                iterator->match.offset = matcher->streamOffset - node->depth;
+                return true;
+            }
+        }
+
+        if (iterator->position >= iterator->length) {
+            return false;
+        }
+        matcher->state = nextState(matcher, matcher->state, iterator->text[iterator->position]);
+        iterator->position++;
+        matcher->streamOffset++;
+        iterator->outputNode = matcher->state;
+    }
+}
+
+StringMatcher *resetStringMatcher(StringMatcher *matcher) {
+    if (matcher == NULL) return NULL;
+    matcher->state = ROOT_NODE;
+    matcher->streamOffset = 0;
+    return matcher;
+}
+
+static uint16_t findChildNode(StringMatcher *matcher, uint16_t node, char symbol) {
+    for (uint16_t child = matcher->nodes[node].firstChild; child != NO_NODE; child = matcher->nodes[child].nextSibling) {
+        if (matcher->nodes[child].symbol == symbol) {
+            return child;
+        }
+    }
+    return NO_NODE;
+}
+
+static uint16_t nextState(StringMatcher *matcher, uint16_t state, char symbol) {
+    while (true) {
+        uint16_t child = findChildNode(matcher, state, symbol);
+        if (child != NO_NODE) {
+            return child;
+        }
+
+        if (state == ROOT_NODE) {
+            return ROOT_NODE;
+        }
+        state = matcher->nodes[state].fail;
+    }
+}
+
+static void linkChildNodes(StringMatcher *matcher, uint16_t parent) {
+    StringMatcherNode *parentNode = &matcher->nodes[parent];
+    for (uint16_t child = parentNode->firstChild; child != NO_NODE; child = matcher->nodes[child].nextSibling) {
+        StringMatcherNode *childNode = &matcher->nodes[child];
+        childNode->fail = (parent == ROOT_NODE) ? ROOT_NODE : nextState(matcher, parentNode->fail, childNode->symbol);
+
+        StringMatcherNode *failNode = &matcher->nodes[childNode->fail];
+        childNode->dictionaryLink = (failNode->patternId != NO_PATTERN) ? childNode->fail : failNode->dictionaryLink;
+    }
+}
@@ -0,0 +1,110 @@
+#include "StringReader.h"
+
+#ifdef ENABLE_POSIX_IO
+#include <unistd.h>
+
+static int32_t readFileDescriptor(char *buffer, uint32_t length, void *context);
+#endif
+
+static StringReader *fillReaderBuffer(StringReader *reader);
+
+
+StringReader *newStringReader(StringReader *reader, char *buffer, uint32_t capacity, StringReadCallback read, void *context, char delimiter) {
+    if (reader == NULL || buffer == NULL || read == NULL || capacity == 0) return NULL;
+    memset(reader, 0, sizeof(StringReader));
+    reader->buffer = buffer;
+    reader->capacity = capacity;
+    reader->delimiter = delimiter;
+    reader->read = read;
+    reader->context = context;
+    reader->status = STRING_READER_OK;
+    return reader;
+}
+
+bool hasNextRecord(StringReader *reader, StringView *record) {
+    if (reader == NULL || record == NULL) return false;
+
+    while (true) {
+        char *recordStart = reader->buffer + reader->start;
+        uint32_t bufferedLength = reader->end - reader->start;
+        char *delimiterPointer = memchr(recordStart + reader->scanned, reader->delimiter, bufferedLength - reader->scanned);
+        if (delimiterPointer != NULL && reader->isSkippingRecord) {     // tail of overflowed record
+            reader->start += delimiterPointer - recordStart + 1;
+            reader->scanned = 0;
+            reader->isSkippingRecord = false;
+            continue;
+        }
+        if (delimiterPointer != NULL) {
+            record->value = recordStart;
+            record->length = delimiterPointer - recordStart;
+            reader->start += record->length + 1;
+            reader->scanned = 0;
+            reader->status = STRING_READER_OK;
+            return true;
+        }
+        reader->scanned = bufferedLength;   // do not scan the same data after next read
+        if (reader->isSkippingRecord) {
+            reader->start = reader->end;
+            reader->scanned = 0;
+            bufferedLength = 0;
+        }
+
+        if (reader->isEndOfStream) {
+            if (bufferedLength == 0) {
+                reader->status = STRING_READER_END_OF_STREAM;
+                return false;
+            }
+            record->value = recordStart;   // last record without delimiter
+            record->length = bufferedLength;
+            reader->start = reader->end;
+            reader->scanned = 0;
+            reader->status = STRING_READER_OK;
+            return true;
+        }
+
+        if (fillReaderBuffer(reader) == NULL) {
+            return false;
+        }
+    }
+}
+
+#ifdef ENABLE_POSIX_IO
+StringReader *newFdStringReader(StringReader *reader, char *buffer, uint32_t capacity, int fd, char delimiter) {
+    return fd >= 0 ? newStringReader(reader, buffer, capacity, readFileDescriptor, (void *) (intptr_t) fd, delimiter) : NULL;
+}
+
+static int32_t readFileDescriptor(char *buffer, uint32_t length, void *context) {
+    ssize_t readLength;
+    do {
+        readLength = read((int) (intptr_t) context, buffer, length);
+    } while (readLength < 0 && errno == EINTR);
+    return (int32_t) readLength;
+}
+#endif
+
+static StringReader *fillReaderBuffer(StringReader *reader) {
+    if (reader->start > 0) {    // move partial record to the buffer start before every read, so all free space is used
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    if (reader->end >= reader->capacity) {
+        reader->start = 0;
+        reader->end = 0;
+        reader->scanned = 0;
+        reader->isSkippingRecord = true;
+        reader->status = STRING_READER_OVERFLOW;
+        return NULL;
+    }
+
+    int32_t readLength = reader->read(reader->buffer + reader->end, reader->capacity - reader->end, reader->context);
+    if (readLength < 0) {
+        reader->status = STRING_READER_READ_ERROR;
+        return NULL;
+    }
+
+    reader->isEndOfStream = (readLength == 0);
+    reader->end += readLength;
+    return reader;
+}
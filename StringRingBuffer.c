@@ -0,0 +1,103 @@
+#include "StringRingBuffer.h"
+
+#define RECORD_HEADER_SIZE sizeof(uint32_t)
+#define RECORD_ALIGNMENT 4
+#define WRAP_MARKER UINT32_MAX  // record header, that tells consumer to continue from the ring start
+#define RECORD_SIZE(length) ((RECORD_HEADER_SIZE + (length) + 1 + (RECORD_ALIGNMENT - 1)) & ~(RECORD_ALIGNMENT - 1))   // with null terminator
+
+#define LOAD_ACQUIRE(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+
+static inline uint32_t readRecordHeader(StringRingBuffer *ring, uint32_t position);
+static inline void writeRecordHeader(StringRingBuffer *ring, uint32_t position, uint32_t header);
+
+
+StringRingBuffer *newStringRingBuffer(StringRingBuffer *ring, char *buffer, uint32_t capacity) {
+    if (ring == NULL || buffer == NULL || capacity < RECORD_SIZE(0) || (capacity % RECORD_ALIGNMENT) != 0) return NULL;
+    ring->buffer = buffer;
+    ring->capacity = capacity;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->reservedStart = 0;
+    return ring;
+}
+
+BufferString *reserveRingString(StringRingBuffer *ring, BufferString *slot, uint32_t maxLength) {
+    if (ring == NULL || slot == NULL || maxLength >= ring->capacity) return NULL;
+    uint32_t recordSize = RECORD_SIZE(maxLength);
+    uint32_t head = ring->head;
+    uint32_t tail = LOAD_ACQUIRE(&ring->tail);
+
+    // head never catches up the tail, so equal positions always mean empty ring
+    if (head >= tail) {
+        uint32_t endSpace = ring->capacity - head;
+        if (recordSize < endSpace || (recordSize == endSpace && tail != 0)) {
+            ring->reservedStart = head;
+
+        } else if (recordSize < tail) {    // not enough space at the end, continue from the start
+            writeRecordHeader(ring, head, WRAP_MARKER);     // not visible for consumer until commit
+            ring->reservedStart = 0;
+
+        } else {
+            return NULL;
+        }
+
+    } else if (recordSize < (tail - head)) {
+        ring->reservedStart = head;
+
+    } else {
+        return NULL;
+    }
+
+    char *slotBuffer = ring->buffer + ring->reservedStart + RECORD_HEADER_SIZE;
+    memset(slotBuffer, 0, maxLength + 1);   // slot memory has previous records, string functions expect zeroed buffer
+    return newStringWithLength(slot, "", 0, slotBuffer, maxLength + 1);
+}
+
+StringRingBuffer *commitRingString(StringRingBuffer *ring, BufferString *slot) {
+    if (ring == NULL || slot == NULL || slot->value != ring->buffer + ring->reservedStart + RECORD_HEADER_SIZE) return NULL;
+    writeRecordHeader(ring, ring->reservedStart, slot->length);
+    uint32_t nextHead = ring->reservedStart + RECORD_SIZE(slot->length);
+    STORE_RELEASE(&ring->head, (nextHead < ring->capacity) ? nextHead : 0);
+    return ring;
+}
+
+uint32_t drainStringRing(StringRingBuffer *ring, StringRingConsumer consumer, void *context, uint32_t maxCount) {
+    if (ring == NULL || consumer == NULL) return 0;
+    uint32_t tail = ring->tail;
+    uint32_t head = LOAD_ACQUIRE(&ring->head);
+    uint32_t count = 0;
+
+    while (tail != head && count < maxCount) {
+        uint32_t header = readRecordHeader(ring, tail);
+        if (header == WRAP_MARKER) {
+            tail = 0;
+            continue;
+        }
+
+        StringView record = {.value = ring->buffer + tail + RECORD_HEADER_SIZE, .length = header};
+        if (!consumer(record, context)) {
+            break;
+        }
+        uint32_t nextTail = tail + RECORD_SIZE(header);
+        tail = (nextTail < ring->capacity) ? nextTail : 0;
+        count++;
+    }
+
+    STORE_RELEASE(&ring->tail, tail);   // release all consumed space at once
+    return count;
+}
+
+bool isStringRingEmpty(StringRingBuffer *ring) {
+    return ring == NULL || LOAD_ACQUIRE(&ring->head) == LOAD_ACQUIRE(&ring->tail);
+}
+
+static inline uint32_t readRecordHeader(StringRingBuffer *ring, uint32_t position) {
+    uint32_t header;
+    memcpy(&header, ring->buffer + position, RECORD_HEADER_SIZE);
+    return header;
+}
+
+static inline void writeRecordHeader(StringRingBuffer *ring, uint32_t position, uint32_t header) {
+    memcpy(ring->buffer + position, &header, RECORD_HEADER_SIZE);
+}
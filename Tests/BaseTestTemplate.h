@@ -8,6 +8,7 @@
 
 #define END_OF_TESTS { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 #define END_OF_PARAMETERS {NULL, NULL}
+#define END_OF_SUITES { NULL, NULL, NULL, 0, MUNIT_SUITE_OPTION_NONE }
 
 #define ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
 
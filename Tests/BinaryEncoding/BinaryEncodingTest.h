@@ -0,0 +1,208 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <BinaryEncoding.h>
+
+static MunitResult testHexEncode(const MunitParameter params[], void *testData) {
+    const uint8_t mac[] = {0x24, 0x6F, 0x28, 0xAB, 0xCD, 0xEF};
+    BufferString *str = NEW_STRING_32("mac=");
+    assert_not_null(hexEncode(str, mac, sizeof(mac), false));
+    assert_string_equal(stringValue(str), "mac=246f28abcdef");
+    assert_not_null(hexEncode(str, mac, 2, true));
+    assert_string_equal(stringValue(str), "mac=246f28abcdef246F");
+
+    uint8_t data[256];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) i;
+    }
+    BufferString *blocks = EMPTY_STRING(1024);    // block and byte by byte paths should give the same result
+    assert_not_null(hexEncode(blocks, data, sizeof(data), true));
+    assert_uint32(blocks->length, ==, 512);
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        BufferString *expected = STRING_FORMAT_16("%X%X", i >> 4, i & 0x0F);
+        assert_memory_equal(2, stringValue(blocks) + i * 2, stringValue(expected));
+    }
+
+    BufferString *small = NEW_STRING_16("ab");
+    assert_null(hexEncode(small, data, 7, false));  // 14 chars and terminator don't fit
+    assert_string_equal(stringValue(small), "ab");
+    assert_not_null(hexEncode(small, data, 6, false));
+    assert_null(hexEncode(NULL, data, 1, false));
+    return MUNIT_OK;
+}
+
+static MunitResult testHexDecode(const MunitParameter params[], void *testData) {
+    BufferString *str = EMPTY_STRING(64);
+    assert_not_null(hexDecode(str, "246f28ABCDEF", 12));
+    assert_uint32(str->length, ==, 6);
+    assert_memory_equal(6, stringValue(str), "\x24\x6F\x28\xAB\xCD\xEF");
+
+    const char *hex = "000102030405060708090a0b0c0d0e0f101112131415161718191A1B1C1D1E1F20ff";
+    BufferString *blocks = EMPTY_STRING(64);
+    assert_not_null(hexDecode(blocks, hex, strlen(hex)));
+    assert_uint32(blocks->length, ==, 34);
+    for (uint32_t i = 0; i < 33; i++) {
+        assert_uint8((uint8_t) stringValue(blocks)[i], ==, i);
+    }
+    assert_uint8((uint8_t) stringValue(blocks)[33], ==, 0xFF);
+
+    const char *invalidBlock = "000102030405060708090a0b0c0d0e0g";   // invalid char in vector block
+    BufferString *invalid = NEW_STRING_64("keep");
+    assert_null(hexDecode(invalid, invalidBlock, strlen(invalidBlock)));
+    assert_null(hexDecode(invalid, "0x12", 4));
+    assert_null(hexDecode(invalid, "123", 3));      // odd length
+    assert_string_equal(stringValue(invalid), "keep");
+    assert_uint32(invalid->length, ==, 4);
+
+    assert_null(hexDecode(NEW_STRING_16("0123456789"), "aabbccddeeff", 12));
+    return MUNIT_OK;
+}
+
+static MunitResult testBase64(const MunitParameter params[], void *testData) {
+    const char *plain[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};  // RFC 4648 test vectors
+    const char *encoded[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(plain); i++) {
+        BufferString *str = EMPTY_STRING(32);
+        assert_not_null(base64Encode(str, (const uint8_t *) plain[i], strlen(plain[i])));
+        assert_string_equal(stringValue(str), encoded[i]);
+        assert_uint32(str->length, ==, BASE64_ENCODED_LENGTH(strlen(plain[i])));
+
+        BufferString *decoded = EMPTY_STRING(32);
+        assert_not_null(base64Decode(decoded, encoded[i], strlen(encoded[i])));
+        assert_string_equal(stringValue(decoded), plain[i]);
+    }
+
+    BufferString *unpadded = EMPTY_STRING(16);
+    assert_not_null(base64Decode(unpadded, "Zm9vYg", 6));
+    assert_string_equal(stringValue(unpadded), "foob");
+
+    const uint8_t binary[] = {0xFB, 0xFF, 0x00, 0x3E};
+    BufferString *binaryStr = EMPTY_STRING(16);
+    assert_not_null(base64Encode(binaryStr, binary, sizeof(binary)));
+    assert_string_equal(stringValue(binaryStr), "+/8APg==");
+
+    BufferString *invalid = NEW_STRING_16("keep");
+    assert_null(base64Decode(invalid, "Zm9v!mFy", 8));
+    assert_null(base64Decode(invalid, "Zm=v", 4));
+    assert_null(base64Decode(invalid, "Zm9vY", 5));  // single char tail
+    assert_null(base64Decode(invalid, "Zm9vYmFyZm9vYmFy", 16));   // 12 bytes don't fit
+    assert_string_equal(stringValue(invalid), "keep");
+    assert_null(base64Encode(NEW_STRING_16("abcdefghijk"), binary, sizeof(binary)));
+    return MUNIT_OK;
+}
+
+static void base64EncodeReference(const uint8_t *data, uint32_t length, char *output) {
+    const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (uint32_t i = 0; i < length; i += 3, output += 4) {
+        uint32_t triple = (uint32_t) data[i] << 16;
+        if (i + 1 < length) triple |= (uint32_t) data[i + 1] << 8;
+        if (i + 2 < length) triple |= data[i + 2];
+        output[0] = alphabet[triple >> 18];
+        output[1] = alphabet[(triple >> 12) & 0x3F];
+        output[2] = (i + 1 < length) ? alphabet[(triple >> 6) & 0x3F] : '=';
+        output[3] = (i + 2 < length) ? alphabet[triple & 0x3F] : '=';
+    }
+    *output = '\0';
+}
+
+static MunitResult testBase64Blocks(const MunitParameter params[], void *testData) {
+    uint8_t data[301];
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t) (seed >> 16);
+    }
+    char expected[512];
+    for (uint32_t length = 0; length < sizeof(data); length++) {   // odd start and lengths for unaligned tails
+        base64EncodeReference(data + 1, length, expected);
+        BufferString *encoded = EMPTY_STRING(512);
+        assert_not_null(base64Encode(encoded, data + 1, length));
+        assert_string_equal(stringValue(encoded), expected);
+
+        BufferString *decoded = EMPTY_STRING(512);
+        assert_not_null(base64Decode(decoded, stringValue(encoded), encoded->length));
+        assert_uint32(decoded->length, ==, length);
+        assert_memory_equal(length, stringValue(decoded), data + 1);
+        assert_char(stringValue(decoded)[length], ==, '\0');
+    }
+
+    base64EncodeReference(data, 96, expected);
+    for (uint32_t position = 0; position < 128; position += 7) {
+        expected[position] = '*';   // invalid char inside of vector block and scalar tail
+        BufferString *invalid = EMPTY_STRING(128);
+        assert_null(base64Decode(invalid, expected, 128));
+        assert_uint32(invalid->length, ==, 0);
+        assert_char(stringValue(invalid)[0], ==, '\0');
+        base64EncodeReference(data, 96, expected);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testHexdump(const MunitParameter params[], void *testData) {
+    const char data[] = "Hello World.\nAT+CIPSEND=4\r\n\x01\xFF";
+    BufferString *str = EMPTY_STRING(512);
+    assert_not_null(hexdumpToString(str, (const uint8_t *) data, sizeof(data) - 1, 0, NULL));
+    assert_string_equal(stringValue(str),
+                        "00000000  48 65 6c 6c 6f 20 57 6f  72 6c 64 2e 0a 41 54 2b  |Hello World..AT+|\n"
+                        "00000010  43 49 50 53 45 4e 44 3d  34 0d 0a 01 ff           |CIPSEND=4....|\n");
+
+    HexdumpFormat format = {.rowWidth = 4, .groupSize = 2, .isUpperCase = true};
+    BufferString *narrow = EMPTY_STRING(128);
+    assert_not_null(hexdumpToString(narrow, (const uint8_t *) "\xAB\xCDxyz", 5, 0x1FFE, &format));
+    assert_string_equal(stringValue(narrow),
+                        "00001FFE  AB CD  78 79  |..xy|\n"
+                        "00002002  7A            |z|\n");
+
+    format.groupSize = 0;
+    BufferString *noGroups = EMPTY_STRING(64);
+    assert_not_null(hexdumpToString(noGroups, (const uint8_t *) "abc", 3, 0, &format));
+    assert_string_equal(stringValue(noGroups), "00000000  61 62 63     |abc|\n");
+
+    BufferString *small = NEW_STRING_128("keep");
+    assert_null(hexdumpToString(small, (const uint8_t *) data, sizeof(data) - 1, 0, NULL));  // second row doesn't fit
+    assert_string_equal(stringValue(small), "keep");
+
+    format.rowWidth = HEXDUMP_MAX_ROW_WIDTH + 1;
+    assert_null(hexdumpToString(str, (const uint8_t *) data, 1, 0, &format));
+    assert_null(hexdumpToString(NULL, (const uint8_t *) data, 1, 0, NULL));
+    return MUNIT_OK;
+}
+
+static bool collectHexdumpOutput(const char *data, uint32_t length, void *context) {
+    return concatCharsByLength((BufferString *) context, data, length) != NULL;
+}
+
+static MunitResult testHexdumpToSink(const MunitParameter params[], void *testData) {
+    uint8_t data[100];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 7);
+    }
+    BufferString *expected = EMPTY_STRING(1024);
+    assert_not_null(hexdumpToString(expected, data, sizeof(data), 0, NULL));
+
+    BufferString *output = EMPTY_STRING(1024);
+    StringSink *sink = NEW_STRING_SINK(32, collectHexdumpOutput, output);    // smaller than the row
+    assert_not_null(hexdumpToSink(sink, data, sizeof(data), 0, NULL));
+    assert_not_null(flushStringSink(sink));
+    assert_string_equal(stringValue(output), stringValue(expected));
+    assert_null(hexdumpToSink(NULL, data, sizeof(data), 0, NULL));
+    return MUNIT_OK;
+}
+
+static MunitTest binaryEncodingTests[] = {
+        {.name =  "Test hexEncode() - should encode bytes to hex", .test = testHexEncode},
+        {.name =  "Test hexDecode() - should decode hex and reject invalid chars", .test = testHexDecode},
+        {.name =  "Test base64Encode() and base64Decode() - should match RFC 4648 vectors", .test = testBase64},
+        {.name =  "Test base64Encode() and base64Decode() - should match scalar results for long inputs", .test = testBase64Blocks},
+        {.name =  "Test hexdumpToString() - should render offset, hex and ASCII rows", .test = testHexdump},
+        {.name =  "Test hexdumpToSink() - should write rows to the sink", .test = testHexdumpToSink},
+        END_OF_TESTS
+};
+
+static const MunitSuite binaryEncodingTestSuite = {
+        .prefix = "BinaryEncoding: ",
+        .tests = binaryEncodingTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
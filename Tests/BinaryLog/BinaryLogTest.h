@@ -0,0 +1,95 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <BinaryLog.h>
+
+enum {
+    LOG_BOOT_ID,
+    LOG_SENSOR_ID,
+    LOG_PACKET_ID,
+    LOG_FORMAT_COUNT
+};
+
+static const char *const LOG_FORMATS[LOG_FORMAT_COUNT] = {
+        [LOG_BOOT_ID] = "boot: version %s, reset cause %U8",
+        [LOG_SENSOR_ID] = "sensor %S: %I16 mV, [%-6d]",
+        [LOG_PACKET_ID] = "packet #%U64 from %#x, %*s",
+};
+
+static MunitResult testEncodeBinaryLog(const MunitParameter params[], void *testData) {
+    BufferString *out = EMPTY_STRING(64);
+    assert_not_null(encodeBinaryLog(out, LOG_BOOT_ID, LOG_FORMATS[LOG_BOOT_ID], "1.2.0", (uint8_t) 3));
+    assert_uint32(out->length, ==, BINARY_LOG_HEADER_SIZE + 4 + 6 + 4);   // chars length, "1.2.0" with terminator, U8
+    assert_uint8(out->value[0], ==, LOG_BOOT_ID);
+    assert_uint8(out->value[2], ==, 14);
+
+    uint32_t previousLength = out->length;
+    assert_null(encodeBinaryLog(out, LOG_BOOT_ID, LOG_FORMATS[LOG_BOOT_ID],
+                                "very long version string, that should not fit into the rest of buffer capacity...............", 1));
+    assert_uint32(out->length, ==, previousLength);     // not changed on overflow
+    assert_uint8(out->value[previousLength], ==, 0);
+    assert_null(encodeBinaryLog(NULL, LOG_BOOT_ID, "", 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testDecodeBinaryLog(const MunitParameter params[], void *testData) {
+    BufferString *out = EMPTY_STRING(256);
+    encodeBinaryLog(out, LOG_BOOT_ID, LOG_FORMATS[LOG_BOOT_ID], "1.2.0", (uint8_t) 3);
+    encodeBinaryLog(out, LOG_SENSOR_ID, LOG_FORMATS[LOG_SENSOR_ID], NEW_STRING_16("vbat"), (int16_t) -3300, 42);
+    encodeBinaryLog(out, LOG_PACKET_ID, LOG_FORMATS[LOG_PACKET_ID], (uint64_t) 12345678901ULL, 0xBEEF, 6, "ok");
+
+    BufferString *line = EMPTY_STRING(128);
+    BinaryLogIterator iterator = getBinaryLogIterator(LOG_FORMATS, LOG_FORMAT_COUNT, (uint8_t *) out->value, out->length);
+    assert_true(hasNextBinaryLog(&iterator, line));
+    assert_string_equal(stringValue(line), "boot: version 1.2.0, reset cause 3");
+    assert_uint16(iterator.formatId, ==, LOG_BOOT_ID);
+    assert_true(hasNextBinaryLog(&iterator, line));
+    assert_string_equal(stringValue(line), "sensor vbat: -3300 mV, [42    ]");
+    assert_true(hasNextBinaryLog(&iterator, line));
+    assert_string_equal(stringValue(line), "packet #12345678901 from 0xbeef,     ok");
+    assert_false(hasNextBinaryLog(&iterator, line));
+    assert_uint32(iterator.offset, ==, out->length);
+    return MUNIT_OK;
+}
+
+static MunitResult testDecodeBinaryLogStream(const MunitParameter params[], void *testData) {
+    BufferString *out = EMPTY_STRING(128);
+    encodeBinaryLog(out, LOG_SENSOR_ID, LOG_FORMATS[LOG_SENSOR_ID], NEW_STRING_16("t1"), (int16_t) 21, 1);
+    uint32_t firstLength = out->length;
+    encodeBinaryLog(out, LOG_SENSOR_ID, LOG_FORMATS[LOG_SENSOR_ID], NEW_STRING_16("t2"), (int16_t) 22, 2);
+
+    BufferString *line = EMPTY_STRING(64);
+    BinaryLogIterator iterator = getBinaryLogIterator(LOG_FORMATS, LOG_FORMAT_COUNT, (uint8_t *) out->value, firstLength + 5);
+    assert_true(hasNextBinaryLog(&iterator, line));
+    assert_false(hasNextBinaryLog(&iterator, line));    // second record is not received completely
+    assert_uint32(iterator.offset, ==, firstLength);
+
+    iterator.length = out->length;  // rest of the data received
+    assert_true(hasNextBinaryLog(&iterator, line));
+    assert_string_equal(stringValue(line), "sensor t2: 22 mV, [2     ]");
+
+    uint8_t unknownRecord[] = {LOG_FORMAT_COUNT, 0, 0, 0};
+    BinaryLogIterator unknownIterator = getBinaryLogIterator(LOG_FORMATS, LOG_FORMAT_COUNT, unknownRecord, sizeof(unknownRecord));
+    assert_false(hasNextBinaryLog(&unknownIterator, line));
+    assert_uint32(unknownIterator.offset, ==, 0);
+
+    uint8_t corruptedRecord[] = {LOG_BOOT_ID, 0, 2, 0, 0xFF, 0xFF};     // string length is cut
+    BinaryLogIterator corruptedIterator = getBinaryLogIterator(LOG_FORMATS, LOG_FORMAT_COUNT, corruptedRecord, sizeof(corruptedRecord));
+    assert_false(hasNextBinaryLog(&corruptedIterator, line));
+    return MUNIT_OK;
+}
+
+static MunitTest binaryLogTests[] = {
+        {.name =  "Test encodeBinaryLog() - should append compact record", .test = testEncodeBinaryLog},
+        {.name =  "Test hasNextBinaryLog() - should render records with format table", .test = testDecodeBinaryLog},
+        {.name =  "Test hasNextBinaryLog() - should stop at incomplete and invalid records", .test = testDecodeBinaryLogStream},
+        END_OF_TESTS
+};
+
+static const MunitSuite binaryLogTestSuite = {
+        .prefix = "BinaryLog: ",
+        .tests = binaryLogTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
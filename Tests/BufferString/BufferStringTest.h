@@ -1576,6 +1576,54 @@ static MunitResult testFormatCustomType(const MunitParameter params[], void *tes
     return MUNIT_OK;
 }
 
+static bool collectSinkOutput(const char *data, uint32_t length, void *context) {
+    BufferString *output = context;
+    assert_uint32(length, >, 0);
+    return concatCharsByLength(output, data, length) != NULL;
+}
+
+static bool failSinkOutput(const char *data, uint32_t length, void *context) {
+    return false;
+}
+
+static MunitResult testStringSink(const MunitParameter params[], void *testData) {
+    BufferString *output = EMPTY_STRING(512);
+    StringSink *sink = NEW_STRING_SINK(8, collectSinkOutput, output);
+    assert_not_null(sink);
+
+    sinkFormat(sink, "[%s], [%5d], [%-4X]%n", "abc", 123, 171);
+    assert_string_equal(stringValue(output), "[abc], [  123], [AB  ");   // only full buffers are flushed
+    assert_string_equal(stringValue(sink->buffer), "]\n");
+    flushStringSink(sink);
+    assert_string_equal(stringValue(output), "[abc], [  123], [AB  ]\n");
+    assert_uint32(stringLength(sink->buffer), ==, 0);
+
+    clearString(output);
+    sinkFormat(sink, "%s|%-12s|%*S|%.3s", "text longer than buffer", "left", 10, NEW_STRING_16("right"), "precision");
+    flushStringSink(sink);
+    assert_string_equal(stringValue(output), "text longer than buffer|left        |     right|pre");
+
+    clearString(output);
+    for (int i = 0; i < 20; i++) {
+        sinkFormat(sink, "%I32,", i);
+    }
+    sinkString(sink, NEW_STRING_16("end"));
+    flushStringSink(sink);
+    assert_string_equal(stringValue(output), "0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,end");
+
+    clearString(output);
+    sinkFormat(sink, "%20d|%llu", 7, 18446744073709551615ULL);  // padded number can't be split
+    assert_string_equal(stringValue(output), "");
+    assert_null(sinkFormat(sink, "%20d", 7));
+
+    StringSink *failSink = NEW_STRING_SINK(4, failSinkOutput, NULL);
+    assert_not_null(sinkFormat(failSink, "ab"));
+    assert_null(sinkFormat(failSink, "cdef"));
+    assert_null(NEW_STRING_SINK(16, NULL, NULL));
+    assert_null(sinkFormat(NULL, "abc"));
+    return MUNIT_OK;
+}
+
 static MunitResult testConcatString(const MunitParameter params[], void *testData) {
     BufferString *first = NEW_STRING_128("first");
     BufferString *second = concatChars(first, " second");
@@ -1653,9 +1701,12 @@ static MunitResult testReplaceAllOccurrences(const MunitParameter params[], void
 static MunitResult testTrimString(const MunitParameter params[], void *testData) {
     const char *stringWithSpaces = munit_parameters_get(params, "stringWithSpaces");
     BufferString *str = NEW_STRING_32(stringWithSpaces);
+    char *buffer = stringValue(str);
     trimAll(str);
     assert_string_equal(stringValue(str), "test");
     assert_int32(stringLength(str), ==, 4);
+    assert_ptr_equal(stringValue(str), buffer);   // compacted in place, buffer and capacity are kept
+    assert_uint32(stringCapacity(str), ==, 32);
 
     BufferString *emptyStr_1 = NEW_STRING_32(" ");
     trimAll(emptyStr_1);
@@ -1669,6 +1720,28 @@ static MunitResult testTrimString(const MunitParameter params[], void *testData)
     return MUNIT_OK;
 }
 
+static MunitResult testTrimToView(const MunitParameter params[], void *testData) {
+    const char *stringWithSpaces = munit_parameters_get(params, "stringWithSpaces");
+    BufferString *str = NEW_STRING_32(stringWithSpaces);
+    StringView view = trimToView(str);
+    assert_uint32(view.length, ==, 4);
+    assert_memory_equal(view.length, view.value, "test");
+    assert_true(view.value >= stringValue(str) && view.value < stringValue(str) + stringLength(str));
+    assert_string_equal(stringValue(str), stringWithSpaces);    // source should not be modified
+
+    StringView emptyView = trimToView(NEW_STRING_32("   \t\n"));
+    assert_uint32(emptyView.length, ==, 0);
+
+    StringView nullView = trimToView(NULL);
+    assert_null(nullView.value);
+    assert_uint32(nullView.length, ==, 0);
+
+    StringView partView = trimStringView((StringView) {.value = "  ab  cd  ", .length = 5});
+    assert_uint32(partView.length, ==, 2);
+    assert_memory_equal(partView.length, partView.value, "ab");
+    return MUNIT_OK;
+}
+
 static MunitResult testReverseString(const MunitParameter params[], void *testData) {
     BufferString *str = NEW_STRING_64("ko eb dluohs gnirts tset desreveR");
     reverseString(str);
@@ -2116,6 +2189,48 @@ static MunitResult testIsBuffStringEquals(const MunitParameter params[], void *t
     return MUNIT_OK;
 }
 
+static MunitResult testStringHash(const MunitParameter params[], void *testData) {
+    assert_uint32(stringHash("", 0), ==, 0x02CC5D05);   // xxHash32 reference values
+    assert_uint32(stringHash("abc", 3), ==, 0x32D153FF);
+    assert_uint32(stringHash("Nobody inspects the spammish repetition", 39), ==, 0xE2293B2F);
+
+    BufferString *str = NEW_STRING_64("+IPD,1,497:GET /api/test HTTP/1.1");
+    assert_uint32(str->hash, ==, 0);
+    uint32_t hash = stringHashCode(str);
+    assert_uint32(hash, ==, stringHash(stringValue(str), stringLength(str)));
+    assert_uint32(str->hash, ==, hash);    // should be cached
+    assert_uint32(stringHashCode(NULL), ==, 0);
+
+    toLowerCase(str);
+    assert_uint32(str->hash, ==, 0);    // modification should invalidate cache
+    assert_uint32(stringHashCode(str), !=, hash);
+
+    concatChar(str, '!');
+    assert_uint32(str->hash, ==, 0);
+    stringHashCode(str);
+    trimAll(str);
+    assert_uint32(str->hash, ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testIsBuffStringEqualsByHash(const MunitParameter params[], void *testData) {
+    BufferString *one = NEW_STRING_32("Connection");
+    BufferString *two = NEW_STRING_32("Connection");
+    BufferString *other = NEW_STRING_32("Connectiom");
+    stringHashCode(one);
+    assert_true(isBuffStrEquals(one, two));   // only one hash cached
+    stringHashCode(two);
+    stringHashCode(other);
+    assert_true(isBuffStrEquals(one, two));
+    assert_false(isBuffStrEquals(one, other));
+
+    char binaryData[] = {'a', '\0', 'b'};
+    char otherBinaryData[] = {'a', '\0', 'c'};
+    assert_false(isBuffStrEquals(NEW_STRING_LEN(8, binaryData, 3), NEW_STRING_LEN(8, otherBinaryData, 3)));    // whole length compared
+    assert_true(isBuffStrEquals(NEW_STRING_LEN(8, binaryData, 3), NEW_STRING_LEN(8, binaryData, 3)));
+    return MUNIT_OK;
+}
+
 static MunitResult testIsBuffStringEqualsIgnoreCase(const MunitParameter params[], void *testData) {
     assert_true(isBuffStrEqualsIgnoreCase(NEW_STRING_16(NULL), NEW_STRING_16(NULL)));
     assert_true(isBuffStrEqualsIgnoreCase(NEW_STRING_16("b"), NEW_STRING_16("b")));
@@ -2436,6 +2551,8 @@ static MunitTest bufferStringTests[] = {
         {.name =  "Test stringFormat() - test format safety check", .test = testFormatBufferSafety},
         {.name =  "Test stringFormat() - test format custom type", .test = testFormatCustomType},
 
+        {.name =  "Test sinkFormat() - should flush formatted output to the callback", .test = testStringSink},
+
         {.name =  "Test concatChars() - should correctly concat chars to string", .test = testConcatString},
         {.name =  "Test copyString() - should correctly copy chars to string", .test = testCopyString},
         {.name =  "Test swapCase() - should correctly change string char case", .test = testSwapCaseString},
@@ -2448,6 +2565,7 @@ static MunitTest bufferStringTests[] = {
         {.name =  "Test replaceAllOccurrences() - should replace all target strings", .test = testReplaceAllOccurrences},
 
         {.name =  "Test trimAll() - should correctly remove trailing whitespaces", .test = testTrimString, .parameters = stringTestParameters1},
+        {.name =  "Test trimToView() - should return view without trailing whitespaces", .test = testTrimToView, .parameters = stringTestParameters1},
         {.name =  "Test reverseString() - should correctly reverse string characters", .test = testReverseString},
         {.name =  "Test capitalize() - should correctly set uppercase to words by delimiter", .test = testCapitalizeString},
 
@@ -2474,6 +2592,8 @@ static MunitTest bufferStringTests[] = {
 
         {.name =  "Test isBuffStringBlank() - should correctly check string blankness", .test = testIsBuffStringBlank},
         {.name =  "Test isBuffStringEquals() - should correctly check string equality", .test = testIsBuffStringEquals},
+        {.name =  "Test stringHash() - should calculate and cache string hash", .test = testStringHash},
+        {.name =  "Test isBuffStringEquals() - should use cached hash and compare whole length", .test = testIsBuffStringEqualsByHash},
         {.name =  "Test isBuffStringEqualsIgnoreCase() - should correctly check string equality ignoring case", .test = testIsBuffStringEqualsIgnoreCase},
 
         {.name =  "Test indexOfChar() - should return index of char or -1 when not found", .test = testIndexOfChar},
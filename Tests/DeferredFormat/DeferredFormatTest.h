@@ -0,0 +1,118 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <DeferredFormat.h>
+
+#define ASSERT_DEFERRED_FORMAT(format, args...) \
+    do { \
+        DeferredFormat *record = deferFormat(NEW_DEFERRED_FORMAT(128), format, args); \
+        assert_not_null(record); \
+        BufferString *rendered = renderDeferredFormat(EMPTY_STRING(256), record); \
+        assert_not_null(rendered); \
+        assert_string_equal(stringValue(rendered), stringValue(STRING_FORMAT(256, format, args))); \
+    } while (0)
+
+static MunitResult testNewDeferredFormat(const MunitParameter params[], void *testData) {
+    DeferredFormat *record = NEW_DEFERRED_FORMAT(64);
+    assert_not_null(record);
+    assert_uint32(record->length, ==, 0);
+    assert_uint32(record->capacity, ==, 64);
+    assert_null(newDeferredFormat(NULL, NULL, 64));
+
+    static uint8_t staticBuffer[32] = {0};
+    assert_not_null(NEW_DEFERRED_FORMAT_BUFF(staticBuffer));
+    return MUNIT_OK;
+}
+
+static MunitResult testDeferFormatNumbers(const MunitParameter params[], void *testData) {
+    ASSERT_DEFERRED_FORMAT("Value: %d, %i, %u", -42, 17, 4000000000U);
+    ASSERT_DEFERRED_FORMAT("[%5d] [%-5d] [%+d] [%04x] [%#8X] [%o] [%b]", 10, 10, 10, 10, 171, 8, 5);
+    ASSERT_DEFERRED_FORMAT("%hhd %hhu %hd %hu", -5, 250, -1000, 60000);
+    ASSERT_DEFERRED_FORMAT("%ld %lu %lld %llu", -123456789L, 123456789UL, -1234567890123LL, 12345678901234ULL);
+    ASSERT_DEFERRED_FORMAT("%I8 %U8 %I16 %U16 %I32 %U32 %I64 %U64", (int8_t) -8, (uint8_t) 8, (int16_t) -16, (uint16_t) 16,
+                           (int32_t) -32, (uint32_t) 32, (int64_t) -64, (uint64_t) 64);
+    ASSERT_DEFERRED_FORMAT("[%*d] [%-*d] [%.*d] [%*.*d]", 5, 10, 4, 7, 3, 1, 6, 4, 12);
+    ASSERT_DEFERRED_FORMAT("[%*d] [%.*d]", -6, 12, -1, 5);  // negative width and precision
+    ASSERT_DEFERRED_FORMAT("%c%c%c %p", 'a', 'b', 'c', (void *) 0x1234);
+    ASSERT_DEFERRED_FORMAT("100%% done%n", 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testDeferFormatStrings(const MunitParameter params[], void *testData) {
+    char mutableValue[] = "original";
+    DeferredFormat *record = deferFormat(NEW_DEFERRED_FORMAT(64), "name: %s, id: %S", mutableValue, NEW_STRING_16("A-17"));
+    assert_not_null(record);
+    mutableValue[0] = 'X';  // string is copied on capture
+    assert_string_equal(stringValue(renderDeferredFormat(EMPTY_STRING(64), record)), "name: original, id: A-17");
+
+    ASSERT_DEFERRED_FORMAT("[%10s] [%-10s] [%.3s] [%.*s]", "right", "left", "truncate", 2, "ab-cd");
+    ASSERT_DEFERRED_FORMAT("[%8S] [%-8S]", NEW_STRING_16("str"), NEW_STRING_16("left"));
+    ASSERT_DEFERRED_FORMAT("%s", "");
+    return MUNIT_OK;
+}
+
+#ifdef ENABLE_FLOAT_FORMATTING
+static MunitResult testDeferFormatFloat(const MunitParameter params[], void *testData) {
+    ASSERT_DEFERRED_FORMAT("%f %.2f %10.3F %e %g", 3.14159, -2.5, 1234.5678, 0.000123, 100000.0);
+    return MUNIT_OK;
+}
+#endif
+
+static MunitResult testDeferFormatOverflow(const MunitParameter params[], void *testData) {
+    assert_null(deferFormat(NEW_DEFERRED_FORMAT(8), "%d %d %d", 1, 2, 3));
+    assert_null(deferFormat(NEW_DEFERRED_FORMAT(8), "%s", "too long string"));
+    assert_null(deferFormat(NEW_DEFERRED_FORMAT(32), "%s", NULL));
+    assert_null(deferFormat(NEW_DEFERRED_FORMAT(32), NULL));
+
+    DeferredFormat *record = deferFormat(NEW_DEFERRED_FORMAT(32), "%d and %s", 1, "text");
+    assert_null(renderDeferredFormat(EMPTY_STRING(8), record));      // output does not fit
+    record->length = 6;     // corrupted, string argument is cut
+    assert_null(renderDeferredFormat(EMPTY_STRING(32), record));
+
+    DeferredFormat *noArguments = deferFormat(NEW_DEFERRED_FORMAT(4), "plain text, unfinished %");
+    assert_not_null(noArguments);
+    assert_uint32(noArguments->length, ==, 0);
+    assert_string_equal(stringValue(renderDeferredFormat(EMPTY_STRING(64), noArguments)), "plain text, unfinished ");
+    return MUNIT_OK;
+}
+
+static MunitResult testDeferSignatureFormat(const MunitParameter params[], void *testData) {
+    DeferredFormatSignature signature;
+    assert_not_null(newDeferredFormatSignature(&signature, "[%*.*d] %s %lld %p %%"));
+    assert_uint8(signature.argumentCount, ==, 6);
+
+    for (int32_t i = 0; i < 3; i++) {
+        DeferredFormat *record = deferSignatureFormat(NEW_DEFERRED_FORMAT(64), &signature, 6, 3, i, "item", -1234567890123LL, (void *) 0x10);
+        assert_not_null(record);
+        assert_string_equal(stringValue(renderDeferredFormat(EMPTY_STRING(64), record)),
+                            stringValue(STRING_FORMAT(64, "[%*.*d] %s %lld %p %%", 6, 3, i, "item", -1234567890123LL, (void *) 0x10)));
+    }
+    assert_null(deferSignatureFormat(NEW_DEFERRED_FORMAT(8), &signature, 6, 3, 1, "item", 1LL, NULL));
+
+    assert_null(newDeferredFormatSignature(&signature, "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d"));
+    assert_null(deferFormat(NEW_DEFERRED_FORMAT(128), "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+                            1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17));
+    assert_null(newDeferredFormatSignature(NULL, "%d"));
+    assert_null(newDeferredFormatSignature(&signature, NULL));
+    return MUNIT_OK;
+}
+
+static MunitTest deferredFormatTests[] = {
+        {.name =  "Test newDeferredFormat() - should correctly create new record", .test = testNewDeferredFormat},
+        {.name =  "Test deferFormat() - should render numbers the same as stringFormat()", .test = testDeferFormatNumbers},
+        {.name =  "Test deferFormat() - should copy and render strings", .test = testDeferFormatStrings},
+#ifdef ENABLE_FLOAT_FORMATTING
+        {.name =  "Test deferFormat() - should render floating point the same as stringFormat()", .test = testDeferFormatFloat},
+#endif
+        {.name =  "Test deferSignatureFormat() - should capture with parsed signature", .test = testDeferSignatureFormat},
+        {.name =  "Test deferFormat() - should fail on overflow and corrupted record", .test = testDeferFormatOverflow},
+        END_OF_TESTS
+};
+
+static const MunitSuite deferredFormatTestSuite = {
+        .prefix = "DeferredFormat: ",
+        .tests = deferredFormatTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
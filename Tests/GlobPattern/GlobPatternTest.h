@@ -0,0 +1,139 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <GlobPattern.h>
+
+#define ASSERT_GLOB_MATCH(pattern, text, expected) \
+    do { \
+        BufferString *matchText = NEW_STRING_128(text); \
+        assert_true(isStrMatchesGlob(matchText, pattern) == (expected)); \
+    } while (0)
+
+static MunitResult testGlobMatch(const MunitParameter params[], void *testData) {
+    ASSERT_GLOB_MATCH("sensors/*/temp?", "sensors/kitchen/temp1", true);
+    ASSERT_GLOB_MATCH("sensors/*/temp?", "sensors/kitchen/temp", false);
+    ASSERT_GLOB_MATCH("sensors/*/temp?", "sensors//tempX", true);
+    ASSERT_GLOB_MATCH("sensors/*/temp?", "sensor/kitchen/temp1", false);
+    ASSERT_GLOB_MATCH("", "", true);
+    ASSERT_GLOB_MATCH("", "a", false);
+    ASSERT_GLOB_MATCH("*", "", true);
+    ASSERT_GLOB_MATCH("**", "anything", true);
+    ASSERT_GLOB_MATCH("abc", "abc", true);
+    ASSERT_GLOB_MATCH("abc", "abcd", false);
+    ASSERT_GLOB_MATCH("a*", "abc", true);
+    ASSERT_GLOB_MATCH("*c", "abc", true);
+    ASSERT_GLOB_MATCH("*b*", "abc", true);
+    ASSERT_GLOB_MATCH("a*b*c", "aXbYc", true);
+    ASSERT_GLOB_MATCH("a*b*c", "acb", false);
+    ASSERT_GLOB_MATCH("ab*ba", "aba", false);     // anchored segments should not overlap
+    ASSERT_GLOB_MATCH("*aab*", "aaaab", true);    // KMP fallback inside literal segment
+    ASSERT_GLOB_MATCH("*abab*c", "ababcababac", true);
+    ASSERT_GLOB_MATCH("*a?c*", "xxabxabcx", true);
+    ASSERT_GLOB_MATCH("*a?c", "abcabd", false);
+    ASSERT_GLOB_MATCH("AT+CIP*", "AT+CIPSEND=4", true);
+    ASSERT_GLOB_MATCH("*\\*", "a*", true);
+    ASSERT_GLOB_MATCH("*\\*", "ab", false);
+    ASSERT_GLOB_MATCH("\\?", "a", false);
+    return MUNIT_OK;
+}
+
+static MunitResult testGlobClasses(const MunitParameter params[], void *testData) {
+    ASSERT_GLOB_MATCH("temp[0-9]", "temp7", true);
+    ASSERT_GLOB_MATCH("temp[0-9]", "tempA", false);
+    ASSERT_GLOB_MATCH("temp[!0-9]", "tempA", true);
+    ASSERT_GLOB_MATCH("temp[^0-9]", "temp7", false);
+    ASSERT_GLOB_MATCH("[a-cx_]*", "x", true);
+    ASSERT_GLOB_MATCH("[a-cx_]*", "_tail", true);
+    ASSERT_GLOB_MATCH("[a-cx_]*", "d", false);
+    ASSERT_GLOB_MATCH("[]]", "]", true);
+    ASSERT_GLOB_MATCH("[!]]", "]", false);
+    ASSERT_GLOB_MATCH("[a-]", "-", true);
+    ASSERT_GLOB_MATCH("[\\]]", "]", true);
+    ASSERT_GLOB_MATCH("*[0-9][0-9]", "log-2024-12", true);
+    ASSERT_GLOB_MATCH("*[0-9][0-9]*.txt", "a1b23.txt", true);
+    ASSERT_GLOB_MATCH("*[0-9][0-9]*.txt", "a1b2.txt", false);
+    return MUNIT_OK;
+}
+
+static MunitResult testCompileGlobPattern(const MunitParameter params[], void *testData) {
+    GlobPattern *glob = NEW_GLOB_PATTERN(32, "sensors/***/temp?");
+    assert_not_null(glob);
+    assert_uint16(glob->tokenCount, ==, 15);  // repeated stars are merged
+    assert_true(glob->tokens[0].isLiteralSegment);
+    assert_false(glob->tokens[9].isLiteralSegment);
+
+    const char *topics[] = {"sensors/kitchen/temp1", "sensors/hall/temp2", "sensors/hall/humidity", "actuators/hall/temp1"};
+    uint32_t matchCount = 0;
+    for (uint32_t i = 0; i < ARRAY_SIZE(topics); i++) {
+        matchCount += isGlobMatch(glob, (StringView) {.value = topics[i], .length = strlen(topics[i])});
+    }
+    assert_uint32(matchCount, ==, 2);
+
+    const char *view = "sensors/a/temp1 and more";
+    assert_true(isGlobMatch(glob, (StringView) {.value = view, .length = 15}));   // view doesn't need terminator
+    assert_false(isGlobMatch(glob, (StringView) {.value = view, .length = 16}));
+
+    GlobToken tokens[4];
+    assert_null(NEW_GLOB_PATTERN_BUFF(tokens, "abcde"));    // not enough tokens
+    assert_not_null(NEW_GLOB_PATTERN_BUFF(tokens, "a*[a-z]?"));
+    assert_null(NEW_GLOB_PATTERN(8, "[a-z"));
+    assert_null(NEW_GLOB_PATTERN(8, "abc\\"));
+    assert_null(NEW_GLOB_PATTERN(8, NULL));
+    assert_null(NEW_GLOB_PATTERN(8, "[a-"));
+    assert_false(isGlobMatchString(glob, NULL));
+    assert_false(isStrMatchesGlob(NEW_STRING_16("abc"), "[abc"));
+    return MUNIT_OK;
+}
+
+static MunitResult testGlobMaskedSegments(const MunitParameter params[], void *testData) {
+    char pattern[] = "*a?aaaa?b*";
+    GlobPattern *glob = NEW_GLOB_PATTERN(16, pattern);
+    assert_not_null(glob);
+    assert_uint8(glob->maskedTokenCount, ==, 8);    // middle segment with '?' is searched by masks
+    memset(pattern, 'x', sizeof(pattern) - 1);     // compiled form doesn't use the pattern string
+
+    BufferString *text = EMPTY_STRING(4096);
+    for (uint32_t i = 0; i < 4000; i++) {
+        concatChar(text, 'a');
+    }
+    assert_false(isGlobMatchString(glob, text));     // single pass over the long run, no retry from every position
+    concatChars(text, "aaXaaaaYb");
+    assert_true(isGlobMatchString(glob, text));
+
+    GlobPattern *classes = NEW_GLOB_PATTERN(32, "id=*[0-9][!0-9]?x*;[a-c]");
+    assert_true(isGlobMatch(classes, (StringView) {.value = "id=a12b7xyz;c", .length = 13}));
+    assert_false(isGlobMatch(classes, (StringView) {.value = "id=a12b7xyz;d", .length = 13}));
+    assert_false(isGlobMatch(classes, (StringView) {.value = "id=ab7x;c", .length = 9}));
+
+    char manyAnyChars[GLOB_MAX_MASKED_TOKENS + 4] = "*";
+    memset(manyAnyChars + 1, '?', GLOB_MAX_MASKED_TOKENS + 1);
+    manyAnyChars[GLOB_MAX_MASKED_TOKENS + 2] = '*';
+    assert_null(NEW_GLOB_PATTERN(GLOB_MAX_MASKED_TOKENS + 4, manyAnyChars));    // more tokens than mask bits
+    manyAnyChars[GLOB_MAX_MASKED_TOKENS + 1] = '*';
+    manyAnyChars[GLOB_MAX_MASKED_TOKENS + 2] = '\0';
+    assert_not_null(NEW_GLOB_PATTERN(GLOB_MAX_MASKED_TOKENS + 4, manyAnyChars));
+
+    GlobPattern *groups = NEW_GLOB_PATTERN(32, "*?abcdefghijklmn*");   // 14 chars and the rest share 15 masks
+    assert_not_null(groups);
+    assert_uint8(groups->charGroupCount, ==, 15);
+    assert_true(isGlobMatch(groups, (StringView) {.value = "xxzabcdefghijklmnyy", .length = 19}));
+    assert_false(isGlobMatch(groups, (StringView) {.value = "xxzabcdefghijklnnyy", .length = 19}));
+    assert_null(NEW_GLOB_PATTERN(32, "*?abcdefghijklmnopq*"));   // more distinct masks than GLOB_MAX_CHAR_GROUPS
+    return MUNIT_OK;
+}
+
+static MunitTest globPatternTests[] = {
+        {.name =  "Test isStrMatchesGlob() - should match stars and single chars", .test = testGlobMatch},
+        {.name =  "Test isStrMatchesGlob() - should match character classes", .test = testGlobClasses},
+        {.name =  "Test compileGlobPattern() - should match views with compiled pattern", .test = testCompileGlobPattern},
+        {.name =  "Test compileGlobPattern() - should search segments with classes by masks", .test = testGlobMaskedSegments},
+        END_OF_TESTS
+};
+
+static const MunitSuite globPatternTestSuite = {
+        .prefix = "GlobPattern: ",
+        .tests = globPatternTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
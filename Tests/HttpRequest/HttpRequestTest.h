@@ -0,0 +1,142 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <HttpRequest.h>
+
+#define ASSERT_VIEW_EQUAL(view, expected) \
+    do { \
+        StringView actualView = (view); \
+        assert_uint32(actualView.length, ==, strlen(expected)); \
+        assert_memory_equal(actualView.length, actualView.value, expected); \
+    } while (0)
+
+static MunitResult testParseHttpRequest(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_256("GET /api/test?id=42&name=a%20b HTTP/1.1\r\n"
+                                       "Host: 192.168.53.117\r\n"
+                                       "Connection:   keep-alive  \r\n"
+                                       "content-length: 4\r\n"
+                                       "\r\n"
+                                       "body");
+    HttpRequest *request = NEW_HTTP_REQUEST(8);
+    assert_not_null(request);
+    assert_int(parseHttpRequest(request, str), ==, HTTP_PARSE_COMPLETE);
+
+    ASSERT_VIEW_EQUAL(request->method, "GET");
+    ASSERT_VIEW_EQUAL(request->path, "/api/test");
+    ASSERT_VIEW_EQUAL(request->query, "id=42&name=a%20b");
+    ASSERT_VIEW_EQUAL(request->version, "HTTP/1.1");
+    assert_uint32(request->headerCount, ==, 3);
+    ASSERT_VIEW_EQUAL(getHttpHeader(request, "host"), "192.168.53.117");
+    ASSERT_VIEW_EQUAL(getHttpHeader(request, "CONNECTION"), "keep-alive");
+    ASSERT_VIEW_EQUAL(getHttpHeader(request, "Content-Length"), "4");
+    assert_null(getHttpHeader(request, "Accept").value);
+    assert_null(getHttpHeader(request, "Hos").value);
+    assert_string_equal(stringValue(str) + request->bodyOffset, "body");
+    assert_ptr_equal(request->path.value, stringValue(str) + 4);    // zero copy
+
+    BufferString *bare = NEW_STRING_128("\nPOST /submit HTTP/1.0\nHost: esp\n\n");   // "\n" line ends, leading empty line
+    HttpHeader headers[2];
+    HttpRequest *bareRequest = NEW_HTTP_REQUEST_BUFF(headers);
+    assert_int(parseHttpRequest(bareRequest, bare), ==, HTTP_PARSE_COMPLETE);
+    ASSERT_VIEW_EQUAL(bareRequest->method, "POST");
+    ASSERT_VIEW_EQUAL(bareRequest->path, "/submit");
+    assert_uint32(bareRequest->query.length, ==, 0);
+    ASSERT_VIEW_EQUAL(getHttpHeader(bareRequest, "host"), "esp");
+    assert_uint32(bareRequest->bodyOffset, ==, bare->length);
+
+    assert_null(newHttpRequest(&(HttpRequest){0}, NULL, 4));
+    assert_int(parseHttpRequest(NULL, str), ==, HTTP_PARSE_INVALID);
+    return MUNIT_OK;
+}
+
+static MunitResult testParseHttpRequestIncrementally(const MunitParameter params[], void *testData) {
+    const char *data = "GET /index.html HTTP/1.1\r\nHost: 192.168.53.117\r\nConnection: close\r\n\r\n";
+    BufferString *str = EMPTY_STRING(128);
+    HttpRequest *request = NEW_HTTP_REQUEST(4);
+
+    uint32_t dataLength = strlen(data);
+    for (uint32_t i = 0; i < dataLength - 1; i++) {    // one byte per read
+        concatCharsByLength(str, data + i, 1);
+        assert_int(parseHttpRequest(request, str), ==, HTTP_PARSE_PARTIAL);
+    }
+    assert_true(request->isRequestLineParsed);
+    assert_uint32(request->headerCount, ==, 2);
+
+    concatChar(str, '\n');
+    assert_int(parseHttpRequest(request, str), ==, HTTP_PARSE_COMPLETE);
+    assert_int(parseHttpRequest(request, str), ==, HTTP_PARSE_COMPLETE);
+    ASSERT_VIEW_EQUAL(request->path, "/index.html");
+    ASSERT_VIEW_EQUAL(getHttpHeader(request, "connection"), "close");
+
+    assert_not_null(newHttpRequest(request, request->headers, request->headerCapacity));  // reset for the next request
+    assert_uint32(request->headerCount, ==, 0);
+    assert_false(request->isComplete);
+    return MUNIT_OK;
+}
+
+static MunitResult testParseInvalidHttpRequest(const MunitParameter params[], void *testData) {
+    const char *invalid[] = {"GET\r\n", "GET  HTTP/1.1\r\n", "GET / HTTP/1.1 \r\n", "GET / FTP/1.1\r\n", "G(T / HTTP/1.1\r\n",
+                             "GET / HTTP/1.1\r\nNo colon\r\n", "GET / HTTP/1.1\r\n: empty\r\n", "GET / HTTP/1.1\r\nBad Name: x\r\n",
+                             "GET / HTTP/1.1\r\nHost: a\r\n  folded\r\n"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int(parseHttpRequest(NEW_HTTP_REQUEST(4), NEW_STRING_64(invalid[i])), ==, HTTP_PARSE_INVALID);
+    }
+
+    HttpRequest *request = NEW_HTTP_REQUEST(1);
+    assert_int(parseHttpRequest(request, NEW_STRING_64("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n")), ==, HTTP_PARSE_TOO_MANY_HEADERS);
+    assert_int(parseHttpRequest(NEW_HTTP_REQUEST(1), EMPTY_STRING(16)), ==, HTTP_PARSE_PARTIAL);
+
+    const char *unsupported[] = {"GET / HTTP/2.0\r\n", "GET / HTTP/1.2\r\n", "GET / HTTP/0.9\r\n"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(unsupported); i++) {
+        assert_int(parseHttpRequest(NEW_HTTP_REQUEST(4), NEW_STRING_64(unsupported[i])), ==, HTTP_PARSE_UNSUPPORTED_VERSION);
+    }
+    assert_int(parseHttpRequest(NEW_HTTP_REQUEST(4), NEW_STRING_64("GET / HTTP/1x1\r\n")), ==, HTTP_PARSE_INVALID);
+    assert_int(parseHttpRequest(NEW_HTTP_REQUEST(4), NEW_STRING_64("GET / HTTP/A.1\r\n")), ==, HTTP_PARSE_INVALID);
+    return MUNIT_OK;
+}
+
+static MunitResult testParseIpdFrame(const MunitParameter params[], void *testData) {
+    const char *frame = "\r\n+IPD,1,24:GET / HTTP/1.1\r\nA: 1\r\n\r\n+IPD,0,";
+    StringView payload = {0};
+    uint32_t linkId = 0;
+    assert_int(parseIpdFrame((StringView) {frame, strlen(frame)}, &payload, &linkId), ==, HTTP_PARSE_COMPLETE);
+    ASSERT_VIEW_EQUAL(payload, "GET / HTTP/1.1\r\nA: 1\r\n\r\n");
+    assert_uint32(linkId, ==, 1);
+
+    HttpRequest *request = NEW_HTTP_REQUEST(4);
+    BufferString *str = EMPTY_STRING(64);
+    concatCharsByLength(str, payload.value, payload.length);
+    assert_int(parseHttpRequest(request, str), ==, HTTP_PARSE_COMPLETE);
+    ASSERT_VIEW_EQUAL(getHttpHeader(request, "a"), "1");
+
+    const char *single = "+IPD,2:OK";
+    assert_int(parseIpdFrame((StringView) {single, strlen(single)}, &payload, &linkId), ==, HTTP_PARSE_COMPLETE);
+    ASSERT_VIEW_EQUAL(payload, "OK");
+    assert_uint32(linkId, ==, UINT32_MAX);
+
+    const char *partial[] = {"", "\r\n+IP", "+IPD,", "+IPD,1", "+IPD,1,", "+IPD,1,25", "+IPD,1,5:GET"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(partial); i++) {
+        assert_int(parseIpdFrame((StringView) {partial[i], strlen(partial[i])}, &payload, NULL), ==, HTTP_PARSE_PARTIAL);
+    }
+    const char *invalid[] = {"GET / HTTP/1.1", "+IPX,1:a", "+IPD,:a", "+IPD,1,x:a", "+IPD,1;a", "+IPD,99999999999:a"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int(parseIpdFrame((StringView) {invalid[i], strlen(invalid[i])}, &payload, NULL), ==, HTTP_PARSE_INVALID);
+    }
+    return MUNIT_OK;
+}
+
+static MunitTest httpRequestTests[] = {
+        {.name =  "Test parseHttpRequest() - should parse request line and headers", .test = testParseHttpRequest},
+        {.name =  "Test parseHttpRequest() - should resume on partial reads", .test = testParseHttpRequestIncrementally},
+        {.name =  "Test parseHttpRequest() - should reject invalid requests", .test = testParseInvalidHttpRequest},
+        {.name =  "Test parseIpdFrame() - should return payload of complete frame", .test = testParseIpdFrame},
+        END_OF_TESTS
+};
+
+static const MunitSuite httpRequestTestSuite = {
+        .prefix = "HttpRequest: ",
+        .tests = httpRequestTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
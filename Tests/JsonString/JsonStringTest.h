@@ -0,0 +1,157 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <JsonString.h>
+
+#define ASSERT_JSON_ESCAPED(value, isEscapeNonAscii, expected) \
+    do { \
+        BufferString *escaped = concatJsonEscaped(EMPTY_STRING(256), value, sizeof(value) - 1, isEscapeNonAscii); \
+        assert_not_null(escaped); \
+        assert_string_equal(stringValue(escaped), expected); \
+    } while (0)
+
+static MunitResult testConcatJsonEscaped(const MunitParameter params[], void *testData) {
+    ASSERT_JSON_ESCAPED("", false, "");
+    ASSERT_JSON_ESCAPED("plain text without escapes", false, "plain text without escapes");
+    ASSERT_JSON_ESCAPED("say \"hi\"", false, "say \\\"hi\\\"");
+    ASSERT_JSON_ESCAPED("C:\\temp\\", false, "C:\\\\temp\\\\");
+    ASSERT_JSON_ESCAPED("line\nnext\r\ttab\b\f", false, "line\\nnext\\r\\ttab\\b\\f");
+    ASSERT_JSON_ESCAPED("\x01\x1F", false, "\\u0001\\u001f");
+    ASSERT_JSON_ESCAPED("a\0b", false, "a\\u0000b");
+    ASSERT_JSON_ESCAPED("Café / Кот", false, "Café / Кот");   // UTF-8 is kept by default
+    ASSERT_JSON_ESCAPED("Café €", true, "Caf\\u00e9 \\u20ac");
+    ASSERT_JSON_ESCAPED("\xF0\x9F\x98\x80", true, "\\ud83d\\ude00");
+    ASSERT_JSON_ESCAPED("long text to check escape in block scan \"quoted\" and after the block\n", false,
+                        "long text to check escape in block scan \\\"quoted\\\" and after the block\\n");
+
+    BufferString *str = NEW_STRING_32("{\"name\":\"");
+    assert_not_null(concatJsonEscaped(str, "a\"b", 3, false));
+    assert_string_equal(stringValue(str), "{\"name\":\"a\\\"b");   // appended to existing value
+
+    BufferString *small = NEW_STRING_16("key:");
+    assert_null(concatJsonEscaped(small, "\"\"\"\"\"\"\"", 7, false));
+    assert_string_equal(stringValue(small), "key:");    // not changed on overflow
+    assert_uint32(small->length, ==, 4);
+    assert_null(concatJsonEscaped(NULL, "", 0, false));
+    return MUNIT_OK;
+}
+
+static MunitResult testUnescapeJsonString(const MunitParameter params[], void *testData) {
+    assert_string_equal(stringValue(unescapeJsonString(NEW_STRING_32("no escapes"))), "no escapes");
+    assert_string_equal(stringValue(unescapeJsonString(NEW_STRING_64("say \\\"hi\\\" \\\\ \\/ \\n\\t"))), "say \"hi\" \\ / \n\t");
+    assert_string_equal(stringValue(unescapeJsonString(NEW_STRING_64("Caf\\u00e9 \\u20AC"))), "Café €");
+    assert_string_equal(stringValue(unescapeJsonString(NEW_STRING_64("\\ud83d\\ude00!"))), "\xF0\x9F\x98\x80!");
+
+    BufferString *escaped = concatJsonEscaped(EMPTY_STRING(128), "Кот \"\x01\" \xF0\x9F\x98\x80\n", 16, true);
+    BufferString *roundTrip = unescapeJsonString(escaped);
+    assert_not_null(roundTrip);
+    assert_string_equal(stringValue(roundTrip), "Кот \"\x01\" \xF0\x9F\x98\x80\n");
+
+    BufferString *invalid = NEW_STRING_32("ok \\n then \\x");
+    assert_null(unescapeJsonString(invalid));
+    assert_string_equal(stringValue(invalid), "ok \\n then \\x");  // not changed
+    assert_null(unescapeJsonString(NEW_STRING_32("\\u12")));
+    assert_null(unescapeJsonString(NEW_STRING_32("\\ud83d alone")));
+    assert_null(unescapeJsonString(NEW_STRING_32("\\ude00")));
+    assert_null(unescapeJsonString(NEW_STRING_32("end\\")));
+    return MUNIT_OK;
+}
+
+static MunitResult testTokenizeJson(const MunitParameter params[], void *testData) {
+    BufferString *json = NEW_STRING_256("{\"cmd\": \"set\", \"id\": -42, \"values\": [1.5, true, null, \"a\\\"b\"], "
+                                        "\"nested\": {\"id\": 7}, \"empty\": {}}");
+    JsonToken tokens[32];
+    int32_t count = tokenizeJson(json, tokens, ARRAY_SIZE(tokens));
+    assert_int32(count, ==, 17);
+
+    assert_int(tokens[0].type, ==, JSON_OBJECT);
+    assert_uint32(tokens[0].size, ==, 5);
+    assert_uint32(tokens[0].length, ==, json->length);
+    assert_int32(tokens[0].parent, ==, -1);
+
+    assert_true(isJsonTokenEquals(json, &tokens[1], "cmd"));
+    assert_uint32(tokens[1].size, ==, 1);
+    assert_int32(tokens[2].parent, ==, 1);      // value belongs to the key
+    assert_true(isJsonTokenEquals(json, &tokens[2], "set"));
+
+    int32_t valuesIndex = findJsonKey(json, tokens, count, 0, "values");
+    assert_int32(valuesIndex, ==, 6);
+    assert_int(tokens[valuesIndex].type, ==, JSON_ARRAY);
+    assert_uint32(tokens[valuesIndex].size, ==, 4);
+    assert_int(tokens[7].type, ==, JSON_NUMBER);
+    assert_int(tokens[8].type, ==, JSON_BOOL);
+    assert_int(tokens[9].type, ==, JSON_NULL);
+    assert_int(tokens[10].type, ==, JSON_STRING);
+    StringView escaped = jsonTokenView(json, &tokens[10]);
+    assert_memory_equal(escaped.length, escaped.value, "a\\\"b");    // not unescaped
+
+    int64_t id = 0;
+    assert_int(jsonTokenToI64(json, &tokens[findJsonKey(json, tokens, count, 0, "id")], &id), ==, STR_TO_I64_SUCCESS);
+    assert_int64(id, ==, -42);
+    int32_t nestedIndex = findJsonKey(json, tokens, count, 0, "nested");
+    assert_int32(findJsonKey(json, tokens, count, nestedIndex, "id"), ==, 14);
+    assert_int32(findJsonKey(json, tokens, count, 0, "missing"), ==, -1);
+    assert_int32(findJsonKey(json, tokens, count, valuesIndex, "id"), ==, -1);    // not an object
+    assert_uint32(tokens[findJsonKey(json, tokens, count, 0, "empty")].size, ==, 0);
+
+    double value = 0;
+    assert_true(jsonTokenToDouble(json, &tokens[7], &value));
+    assert_double_equal(value, 1.5, 6);
+    assert_false(jsonTokenToDouble(json, &tokens[8], &value));
+    assert_int(jsonTokenToI64(json, &tokens[7], &id), ==, STR_TO_I64_INCONVERTIBLE);
+
+    assert_int32(tokenizeJson(NEW_STRING_16(" 12 "), tokens, 1), ==, 1);    // any root value
+    assert_int32(tokenizeJson(NEW_STRING_16("\"\""), tokens, 1), ==, 1);
+    assert_int32(tokenizeJson(NULL, tokens, 1), ==, JSON_ERROR_INVALID);
+    return MUNIT_OK;
+}
+
+static MunitResult testTokenizeJsonErrors(const MunitParameter params[], void *testData) {
+    JsonToken tokens[8];
+    const char *invalid[] = {"{\"a\" 1}", "{\"a\":1,}", "[1 2]", "[1,]", "{1:2}", "[01]", "[1.]", "[tru]", "[\"a\x01\"]",
+                             "[\"\\x\"]", "{\"a\":1]", "[]]", "1 2", "{\"a\":[}", ":", "[-]"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int32(tokenizeJson(NEW_STRING_32(invalid[i]), tokens, ARRAY_SIZE(tokens)), ==, JSON_ERROR_INVALID);
+    }
+
+    const char *partial[] = {"", "{", "{\"a\"", "{\"a\":", "[1,", "[\"abc", "[\"\\u12", "tr", "{\"a\":{}"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(partial); i++) {
+        assert_int32(tokenizeJson(NEW_STRING_32(partial[i]), tokens, ARRAY_SIZE(tokens)), ==, JSON_ERROR_PARTIAL);
+    }
+
+    assert_int32(tokenizeJson(NEW_STRING_32("[1,2,3]"), tokens, 3), ==, JSON_ERROR_NO_TOKENS);
+    assert_int32(tokenizeJson(NEW_STRING_32("[1,2,3]"), tokens, 4), ==, 4);
+
+    BufferString *numbers = NEW_STRING_128("[9223372036854775807, -9223372036854775808, 9223372036854775808, "
+                                           "-9223372036854775809, 1e3, -0.25E-2]");
+    assert_int32(tokenizeJson(numbers, tokens, ARRAY_SIZE(tokens)), ==, 7);
+    int64_t value;
+    assert_int(jsonTokenToI64(numbers, &tokens[1], &value), ==, STR_TO_I64_SUCCESS);
+    assert_int64(value, ==, INT64_MAX);
+    assert_int(jsonTokenToI64(numbers, &tokens[2], &value), ==, STR_TO_I64_SUCCESS);
+    assert_int64(value, ==, INT64_MIN);
+    assert_int(jsonTokenToI64(numbers, &tokens[3], &value), ==, STR_TO_I64_OVERFLOW);
+    assert_int(jsonTokenToI64(numbers, &tokens[4], &value), ==, STR_TO_I64_UNDERFLOW);
+    double doubleValue;
+    assert_true(jsonTokenToDouble(numbers, &tokens[5], &doubleValue));
+    assert_double_equal(doubleValue, 1000.0, 6);
+    assert_true(jsonTokenToDouble(numbers, &tokens[6], &doubleValue));
+    assert_double_equal(doubleValue, -0.0025, 6);
+    return MUNIT_OK;
+}
+
+static MunitTest jsonStringTests[] = {
+        {.name =  "Test concatJsonEscaped() - should escape JSON string", .test = testConcatJsonEscaped},
+        {.name =  "Test unescapeJsonString() - should unescape in place", .test = testUnescapeJsonString},
+        {.name =  "Test tokenizeJson() - should tokenize nested values", .test = testTokenizeJson},
+        {.name =  "Test tokenizeJson() - should report invalid and partial json", .test = testTokenizeJsonErrors},
+        END_OF_TESTS
+};
+
+static const MunitSuite jsonStringTestSuite = {
+        .prefix = "JsonString: ",
+        .tests = jsonStringTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
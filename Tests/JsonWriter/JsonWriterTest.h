@@ -0,0 +1,126 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <JsonWriter.h>
+
+static bool collectJsonOutput(const char *data, uint32_t length, void *context) {
+    return concatCharsByLength((BufferString *) context, data, length) != NULL;
+}
+
+static MunitResult testJsonWriterObject(const MunitParameter params[], void *testData) {
+    BufferString *json = EMPTY_STRING(256);
+    JsonWriter *writer = NEW_JSON_WRITER(json);
+    assert_not_null(writer);
+    assert_false(isJsonWriterComplete(writer));
+
+    assert_not_null(jsonBeginObject(writer));
+    assert_not_null(jsonInt(jsonKey(writer, "id"), -42));
+    assert_not_null(jsonUInt(jsonKey(writer, "serial"), UINT64_MAX));
+    assert_not_null(jsonString(jsonKey(writer, "name"), "sensor \"A\"\n"));
+    assert_not_null(jsonBeginArray(jsonKey(writer, "values")));
+    assert_not_null(jsonBool(jsonBool(jsonNull(writer), true), false));
+    assert_not_null(jsonBeginObject(writer));
+    assert_not_null(jsonEndObject(writer));
+    assert_not_null(jsonBeginArray(writer));
+    assert_not_null(jsonEndArray(writer));
+    assert_not_null(jsonEndArray(writer));
+    assert_not_null(jsonRaw(jsonKeyView(writer, (StringView) {.value = "rawed", .length = 3}), "[1,2]", 5));
+    assert_not_null(jsonBufferString(jsonKey(writer, "str"), NEW_STRING_16("text")));
+    assert_not_null(jsonEndObject(writer));
+
+    assert_string_equal(stringValue(json), "{\"id\":-42,\"serial\":18446744073709551615,\"name\":\"sensor \\\"A\\\"\\n\","
+                                           "\"values\":[null,true,false,{},[]],\"raw\":[1,2],\"str\":\"text\"}");
+    assert_true(isJsonWriterComplete(writer));
+    assert_null(jsonNull(writer));  // only one root value
+
+    JsonWriter *rootWriter = NEW_JSON_WRITER(EMPTY_STRING(16));
+    assert_not_null(jsonString(rootWriter, "root"));
+    assert_true(isJsonWriterComplete(rootWriter));
+    assert_string_equal(stringValue(rootWriter->str), "\"root\"");
+
+    assert_null(NEW_JSON_WRITER(NULL));
+    assert_null(jsonBeginObject(NULL));
+    return MUNIT_OK;
+}
+
+static MunitResult testJsonWriterInvalidStructure(const MunitParameter params[], void *testData) {
+    JsonWriter *writer = NEW_JSON_WRITER(EMPTY_STRING(128));
+    assert_null(jsonKey(writer, "key"));    // no object
+    assert_null(jsonEndObject(writer));
+    jsonBeginObject(writer);
+    assert_null(jsonInt(writer, 1));        // value without key
+    assert_null(jsonEndArray(writer));      // not matching end
+    assert_not_null(jsonKey(writer, "key"));
+    assert_null(jsonKey(writer, "other"));  // key after key
+    assert_null(jsonEndObject(writer));     // key without value
+    assert_not_null(jsonBeginArray(writer));
+    assert_null(jsonKey(writer, "key"));    // arrays have no keys
+    assert_null(jsonEndObject(writer));
+    assert_null(jsonString(writer, NULL));
+
+    JsonWriter *deepWriter = NEW_JSON_WRITER(EMPTY_STRING(128));
+    for (uint32_t i = 0; i < JSON_WRITER_MAX_DEPTH; i++) {
+        assert_not_null(jsonBeginArray(deepWriter));
+    }
+    assert_null(jsonBeginArray(deepWriter));
+    assert_null(jsonBeginObject(deepWriter));
+    for (uint32_t i = 0; i < JSON_WRITER_MAX_DEPTH; i++) {
+        assert_not_null(jsonEndArray(deepWriter));
+    }
+    assert_true(isJsonWriterComplete(deepWriter));
+
+    JsonWriter *smallWriter = NEW_JSON_WRITER(EMPTY_STRING(8));
+    jsonBeginArray(smallWriter);
+    assert_null(jsonString(smallWriter, "overflow"));
+    return MUNIT_OK;
+}
+
+static MunitResult testJsonWriterDouble(const MunitParameter params[], void *testData) {
+#ifdef ENABLE_FLOAT_FORMATTING
+    JsonWriter *writer = NEW_JSON_WRITER(EMPTY_STRING(128));
+    jsonBeginArray(writer);
+    assert_not_null(jsonDouble(writer, 21.5, 2));
+    assert_not_null(jsonDouble(writer, -3.5, 3));
+    assert_not_null(jsonDouble(writer, 0.0 / 0.0, 2));
+    assert_not_null(jsonDouble(writer, 1.0 / 0.0, 2));
+    jsonEndArray(writer);
+    assert_string_equal(stringValue(writer->str), "[21.50,-3.500,null,null]");
+#endif
+    return MUNIT_OK;
+}
+
+static MunitResult testJsonSinkWriter(const MunitParameter params[], void *testData) {
+    BufferString *output = EMPTY_STRING(512);
+    StringSink *sink = NEW_STRING_SINK(16, collectJsonOutput, output);
+    JsonWriter *writer = NEW_JSON_SINK_WRITER(sink);
+    assert_not_null(writer);
+
+    jsonBeginObject(writer);
+    assert_not_null(jsonString(jsonKey(writer, "short"), "fits"));
+    assert_not_null(jsonString(jsonKey(writer, "long"), "value longer than sink buffer with \"quotes\" and\ttabs"));
+    assert_not_null(jsonInt(jsonKey(writer, "count"), 1234567890));
+    jsonEndObject(writer);
+    assert_not_null(flushStringSink(sink));
+
+    assert_string_equal(stringValue(output), "{\"short\":\"fits\",\"long\":\"value longer than sink buffer with "
+                                             "\\\"quotes\\\" and\\ttabs\",\"count\":1234567890}");
+    assert_true(isJsonWriterComplete(writer));
+    assert_null(NEW_JSON_SINK_WRITER(NULL));
+    return MUNIT_OK;
+}
+
+static MunitTest jsonWriterTests[] = {
+        {.name =  "Test JSON writer - should write nested objects and values", .test = testJsonWriterObject},
+        {.name =  "Test JSON writer - should reject invalid structure", .test = testJsonWriterInvalidStructure},
+        {.name =  "Test jsonDouble() - should write fixed point and null for NaN", .test = testJsonWriterDouble},
+        {.name =  "Test JSON sink writer - should flush and split long strings", .test = testJsonSinkWriter},
+        END_OF_TESTS
+};
+
+static const MunitSuite jsonWriterTestSuite = {
+        .prefix = "JsonWriter: ",
+        .tests = jsonWriterTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <MappedString.h>
+#include <unistd.h>
+
+static void createTestFile(char *path, const char *content, uint32_t length) {
+    strcpy(path, "/tmp/mappedStringTestXXXXXX");
+    int fd = mkstemp(path);
+    assert_int(fd, >=, 0);
+    assert_int(write(fd, content, length), ==, length);
+    close(fd);
+}
+
+static MunitResult testMapFileToString(const MunitParameter params[], void *testData) {
+    const char *content = "+CWLAP:(3,\"CVBJB\",-71,\"f8:e4:fb:5b:a9:5a\")\n"
+                          "+CWLAP:(3,\"CLDRM\",-69,\"22:c9:d0:1a:f6:54\")\n"
+                          "+CWLAP:(0,\"AllSaints-Guest\",-83,\"c4:01:7c:7b:08:48\")";
+    char path[64];
+    createTestFile(path, content, strlen(content));
+
+    MappedString mapped = {0};
+    BufferString *str = mapFileToString(&mapped, path);
+    assert_not_null(str);
+    assert_uint32(stringLength(str), ==, strlen(content));
+    assert_string_equal(stringValue(str), content);
+    assert_true(isBuffStrEqualsCstr(str, content));
+
+    assert_int32(indexOfString(str, "CLDRM", 0), ==, 54);
+    assert_int32(lastIndexOfString(str, "+CWLAP"), ==, 86);
+    assert_true(isStrEndsWith(str, "08:48\")"));
+    assert_string_equal(stringValue(SUBSTRING_BETWEEN(32, str, "(0,\"", "\"")), "AllSaints-Guest");
+
+    uint32_t lineCount = 0;
+    BufferString *token = EMPTY_STRING(64);
+    StringIterator iterator = getStringSplitIterator(str, "\n");
+    while (hasNextSplitToken(&iterator, token)) {
+        assert_true(isStrStartsWith(token, "+CWLAP:(", 0));
+        lineCount++;
+    }
+    assert_uint32(lineCount, ==, 3);
+
+    assert_null(concatChars(str, "x"));    // read only, no free space
+    assert_null(concatChar(str, 'x'));
+    assert_not_null(concatChars(str, ""));  // only terminator is rewritten
+    assert_not_null(concatCharsByLength(str, "x", 0));
+    assert_string_equal(stringValue(str), content);
+
+    unmapFileString(&mapped);
+    assert_null(mapped.str.value);
+    unlink(path);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapPageSizeFile(const MunitParameter params[], void *testData) {
+    uint32_t pageSize = sysconf(_SC_PAGESIZE);
+    char *content = generateRandomString(pageSize + 1);   // exactly one page without terminator
+    char path[64];
+    createTestFile(path, content, pageSize);
+
+    MappedString mapped = {0};
+    BufferString *str = mapFileToString(&mapped, path);
+    assert_not_null(str);
+    assert_uint32(stringLength(str), ==, pageSize);
+    assert_uint32(strlen(stringValue(str)), ==, pageSize);  // should be null terminated after the last page
+    assert_memory_equal(pageSize, stringValue(str), content);
+    assert_not_null(concatChars(str, ""));
+    unmapFileString(&mapped);
+    unlink(path);
+    free(content);
+
+    createTestFile(path, "", 0);
+    str = mapFileToString(&mapped, path);
+    assert_not_null(str);
+    assert_uint32(stringLength(str), ==, 0);
+    assert_string_equal(stringValue(str), "");
+    assert_not_null(concatChars(str, ""));
+    assert_null(concatChar(str, 'x'));
+    unmapFileString(&mapped);
+    unlink(path);
+
+    assert_null(mapFileToString(&mapped, "/tmp"));  // not regular files have no reliable size
+    if (access("/proc/self/status", R_OK) == 0) {
+        assert_null(mapFileToString(&mapped, "/proc/self/status"));
+    }
+
+    assert_null(mapFileToString(&mapped, "/tmp/notExistingMappedStringFile"));
+    assert_null(mapFileToString(NULL, path));
+    return MUNIT_OK;
+}
+
+static MunitTest mappedStringTests[] = {
+        {.name =  "Test mapFileToString() - should map file to read only string", .test = testMapFileToString},
+        {.name =  "Test mapFileToString() - should terminate page sized and empty files", .test = testMapPageSizeFile},
+        END_OF_TESTS
+};
+
+static const MunitSuite mappedStringTestSuite = {
+        .prefix = "MappedString: ",
+        .tests = mappedStringTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
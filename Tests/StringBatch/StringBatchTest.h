@@ -0,0 +1,154 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringBatch.h>
+
+#ifdef ENABLE_MULTITHREADING
+#define BATCH_TEST_SIZE 1000
+
+static BufferString *lowerCaseBatchOperation(BufferString *str, uint32_t index, void *context) {
+    return toLowerCase(str);
+}
+
+static BufferString *replaceBatchOperation(BufferString *str, uint32_t index, void *context) {
+    return replaceAllOccurrences(str, "-", context);
+}
+
+static BufferString *parseBatchOperation(BufferString *str, uint32_t index, void *context) {
+    int64_t *values = context;
+    return stringToI64(trimAll(str), &values[index], 10) == STR_TO_I64_SUCCESS ? str : NULL;
+}
+
+static MunitResult testRunStringBatch(const MunitParameter params[], void *testData) {
+    static char buffers[BATCH_TEST_SIZE][32];
+    static BufferString strings[BATCH_TEST_SIZE];
+    static BufferString *stringPointers[BATCH_TEST_SIZE];
+    for (uint32_t i = 0; i < BATCH_TEST_SIZE; i++) {
+        memset(buffers[i], 0, sizeof(buffers[i]));
+        stringPointers[i] = stringFormat(newString(&strings[i], "", buffers[i], sizeof(buffers[i])), "RECORD-%u", i);
+    }
+
+    StringBatchPool *pool = NEW_STRING_BATCH_POOL(3);
+    assert_not_null(pool);
+    assert_uint32(runStringBatch(pool, stringPointers, BATCH_TEST_SIZE, lowerCaseBatchOperation, NULL, NULL), ==, 0);
+    for (uint32_t i = 0; i < BATCH_TEST_SIZE; i++) {
+        assert_string_equal(stringValue(stringPointers[i]), stringValue(STRING_FORMAT_32("record-%u", i)));
+    }
+
+    static BufferString *results[BATCH_TEST_SIZE];
+    uint32_t failedCount = runStringBatch(pool, stringPointers, BATCH_TEST_SIZE, replaceBatchOperation, " number ", results);
+    assert_uint32(failedCount, ==, 0);
+    assert_ptr_equal(results[7], stringPointers[7]);
+    assert_string_equal(stringValue(stringPointers[7]), "record number 7");
+
+    assert_not_null(stopStringBatchPool(pool));
+    return MUNIT_OK;
+}
+
+static MunitResult testRunStringBatchFailures(const MunitParameter params[], void *testData) {
+    static char buffers[BATCH_TEST_SIZE][16];
+    static BufferString strings[BATCH_TEST_SIZE];
+    static BufferString *stringPointers[BATCH_TEST_SIZE];
+    for (uint32_t i = 0; i < BATCH_TEST_SIZE; i++) {
+        memset(buffers[i], 0, sizeof(buffers[i]));
+        const char *format = (i % 10 == 0) ? " x%u " : " %u ";  // every 10th is not a number
+        stringPointers[i] = stringFormat(newString(&strings[i], "", buffers[i], sizeof(buffers[i])), format, i);
+    }
+
+    static int64_t values[BATCH_TEST_SIZE];
+    static BufferString *results[BATCH_TEST_SIZE];
+    StringBatchPool *pool = NEW_STRING_BATCH_POOL(2);
+    assert_uint32(runStringBatch(pool, stringPointers, BATCH_TEST_SIZE, parseBatchOperation, values, results), ==, BATCH_TEST_SIZE / 10);
+    for (uint32_t i = 0; i < BATCH_TEST_SIZE; i++) {
+        if (i % 10 == 0) {
+            assert_null(results[i]);
+        } else {
+            assert_not_null(results[i]);
+            assert_int64(values[i], ==, i);
+        }
+    }
+
+    assert_uint32(runStringBatch(pool, stringPointers, 0, parseBatchOperation, values, NULL), ==, 0);   // empty batch
+    assert_uint32(runStringBatch(pool, stringPointers, 5, NULL, NULL, NULL), ==, 5);
+    stopStringBatchPool(pool);
+
+    StringBatchPool *singleThreadPool = NEW_STRING_BATCH_POOL(1);  // batch smaller than a chunk, done by one thread
+    assert_uint32(runStringBatch(singleThreadPool, stringPointers, 20, parseBatchOperation, values, NULL), ==, 2);
+    stopStringBatchPool(singleThreadPool);
+    return MUNIT_OK;
+}
+static MunitResult testParallelIndexOfString(const MunitParameter params[], void *testData) {
+    static char largeBuffer[300000];
+    memset(largeBuffer, 'a', sizeof(largeBuffer) - 1);
+    largeBuffer[sizeof(largeBuffer) - 1] = '\0';
+    BufferString *str = newStringWithLength(&(BufferString){0}, largeBuffer, sizeof(largeBuffer) - 1, largeBuffer, sizeof(largeBuffer));
+
+    StringBatchPool *pool = NEW_STRING_BATCH_POOL(3);
+    assert_int32(parallelIndexOfString(pool, str, "ERROR"), ==, -1);
+
+    uint32_t chunkBorder = (str->length + 4) / 5;   // 5 chunks of 60000 chars
+    memcpy(&str->value[chunkBorder - 2], "ERROR", 5);     // match on the border of the first and second chunk
+    memcpy(&str->value[250000], "ERROR", 5);
+    assert_int32(parallelIndexOfString(pool, str, "ERROR"), ==, chunkBorder - 2);
+    assert_int32(parallelIndexOfString(pool, str, "ERROR"), ==, indexOfString(str, "ERROR", 0));
+
+    memcpy(&str->value[str->length - 3], "END", 3);
+    assert_int32(parallelIndexOfString(pool, str, "END"), ==, str->length - 3);
+
+    assert_int32(parallelIndexOfString(pool, str, ""), ==, -1);
+    assert_int32(parallelIndexOfString(pool, NEW_STRING_16("short"), "longer needle"), ==, -1);
+    assert_int32(parallelIndexOfString(pool, NEW_STRING_16("in small"), "small"), ==, 3);
+    assert_int32(parallelIndexOfString(NULL, str, "END"), ==, -1);
+    stopStringBatchPool(pool);
+    return MUNIT_OK;
+}
+
+static MunitResult testParallelFindAllStrings(const MunitParameter params[], void *testData) {
+    static char largeBuffer[400000];
+    memset(largeBuffer, '.', sizeof(largeBuffer) - 1);
+    largeBuffer[sizeof(largeBuffer) - 1] = '\0';
+    BufferString *str = newStringWithLength(&(BufferString){0}, largeBuffer, sizeof(largeBuffer) - 1, largeBuffer, sizeof(largeBuffer));
+
+    uint32_t expected[64];
+    for (uint32_t i = 0; i < ARRAY_SIZE(expected); i++) {
+        expected[i] = i * 6199 + 17;
+        memcpy(&str->value[expected[i]], "need", 4);
+    }
+    memcpy(&str->value[399990], "aaaa", 4);    // overlapping matches
+
+    StringBatchPool *pool = NEW_STRING_BATCH_POOL(2);
+    uint32_t offsets[128] = {0};
+    assert_uint32(parallelFindAllStrings(pool, str, "need", offsets, ARRAY_SIZE(offsets)), ==, ARRAY_SIZE(expected));
+    assert_memory_equal(sizeof(expected), offsets, expected);
+
+    assert_uint32(parallelFindAllStrings(pool, str, "aa", offsets, ARRAY_SIZE(offsets)), ==, 3);
+    assert_uint32(offsets[0], ==, 399990);
+    assert_uint32(offsets[2], ==, 399992);
+
+    uint32_t fewOffsets[10] = {0};
+    assert_uint32(parallelFindAllStrings(pool, str, "need", fewOffsets, ARRAY_SIZE(fewOffsets)), ==, ARRAY_SIZE(expected));
+    assert_memory_equal(sizeof(fewOffsets), fewOffsets, expected);   // only the first offsets are stored
+    assert_uint32(parallelFindAllStrings(pool, str, "need", NULL, 0), ==, ARRAY_SIZE(expected));
+    assert_uint32(parallelFindAllStrings(pool, str, "none", offsets, ARRAY_SIZE(offsets)), ==, 0);
+    stopStringBatchPool(pool);
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest stringBatchTests[] = {
+#ifdef ENABLE_MULTITHREADING
+        {.name =  "Test runStringBatch() - should apply operation to all strings", .test = testRunStringBatch},
+        {.name =  "Test runStringBatch() - should report failures per element", .test = testRunStringBatchFailures},
+        {.name =  "Test parallelIndexOfString() - should find first match in chunks", .test = testParallelIndexOfString},
+        {.name =  "Test parallelFindAllStrings() - should find all matches in order", .test = testParallelFindAllStrings},
+#endif
+        END_OF_TESTS
+};
+
+static const MunitSuite stringBatchTestSuite = {
+        .prefix = "StringBatch: ",
+        .tests = stringBatchTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringIntern.h>
+
+static MunitResult testNewStringInternTable(const MunitParameter params[], void *testData) {
+    StringInternTable *table = NEW_STRING_INTERN_TABLE(256, 16);
+    assert_not_null(table);
+    assert_uint32(internedCount(table), ==, 0);
+    assert_uint32(internArenaLength(table), ==, 0);
+
+    assert_null(NEW_STRING_INTERN_TABLE(256, 10));   // entry capacity is not power of two
+    assert_null(newStringInternTable(NULL, NULL, 0, NULL, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testInternString(const MunitParameter params[], void *testData) {
+    StringInternTable *table = NEW_STRING_INTERN_TABLE(256, 16);
+    BufferString *topic = NEW_STRING_32("sensors/kitchen/temp");
+
+    StringView first = internString(table, topic);
+    assert_not_null(first.value);
+    assert_uint32(first.length, ==, 20);
+    assert_string_equal(first.value, "sensors/kitchen/temp");    // interned strings are null terminated
+    assert_ptr_not_equal(first.value, stringValue(topic));
+
+    StringView second = internCStr(table, "sensors/kitchen/temp");
+    StringView third = internString(table, NEW_STRING_64("sensors/kitchen/temp"));
+    assert_true(isInternedEquals(first, second));
+    assert_true(isInternedEquals(first, third));
+    assert_uint32(internedCount(table), ==, 1);
+    assert_uint32(internArenaLength(table), ==, 21);   // stored only once
+
+    StringView other = internCStr(table, "sensors/kitchen/hum");
+    assert_false(isInternedEquals(first, other));
+    assert_uint32(internedCount(table), ==, 2);
+
+    StringView partView = {.value = "Host: 192.168.53.117", .length = 4};
+    StringView host = internView(table, partView);
+    assert_string_equal(host.value, "Host");
+
+    assert_true(isInternedEquals(findInterned(table, (StringView) {.value = "Host", .length = 4}), host));
+    assert_null(findInterned(table, (StringView) {.value = "Hos", .length = 3}).value);
+    assert_null(internCStr(table, NULL).value);
+    assert_null(internString(NULL, topic).value);
+
+    clearStringInternTable(table);
+    assert_uint32(internedCount(table), ==, 0);
+    assert_null(findInterned(table, (StringView) {.value = "Host", .length = 4}).value);
+    return MUNIT_OK;
+}
+
+static MunitResult testInternTableOverflow(const MunitParameter params[], void *testData) {
+    StringInternTable *arenaLimited = NEW_STRING_INTERN_TABLE(8, 16);
+    assert_not_null(internCStr(arenaLimited, "abc").value);
+    assert_null(internCStr(arenaLimited, "defg").value);    // 4 chars and terminator do not fit
+    assert_not_null(internCStr(arenaLimited, "def").value);
+    assert_not_null(internCStr(arenaLimited, "abc").value); // existing string still can be found
+    assert_uint32(internArenaLength(arenaLimited), ==, 8);
+
+    StringInternTable *indexLimited = NEW_STRING_INTERN_TABLE(64, 2);
+    assert_not_null(internCStr(indexLimited, "a").value);
+    assert_not_null(internCStr(indexLimited, "b").value);
+    assert_null(internCStr(indexLimited, "c").value);
+    assert_uint32(internArenaLength(indexLimited), ==, 4);  // failed string should not take arena space
+    return MUNIT_OK;
+}
+
+static MunitTest stringInternTests[] = {
+        {.name =  "Test newStringInternTable() - should correctly create new intern table", .test = testNewStringInternTable},
+        {.name =  "Test internString() - should store every unique string once", .test = testInternString},
+        {.name =  "Test internString() - should not overflow arena and index", .test = testInternTableOverflow},
+        END_OF_TESTS
+};
+
+static const MunitSuite stringInternTestSuite = {
+        .prefix = "StringIntern: ",
+        .tests = stringInternTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringIoVector.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define IO_VECTOR_LARGE_BODY_SIZE (256 * 1024)     // larger than default pipe buffer
+
+static uint32_t readPipe(int fd, char *buffer, uint32_t capacity) {
+    uint32_t length = 0;
+    ssize_t readLength;
+    while (length < capacity && (readLength = read(fd, buffer + length, capacity - length)) > 0) {
+        length += readLength;
+    }
+    return length;
+}
+
+static MunitResult testNewStringIoVector(const MunitParameter params[], void *testData) {
+    StringIoVector *ioVector = NEW_STRING_IO_VECTOR(2);
+    assert_not_null(ioVector);
+    assert_true(isStringIoVectorDone(ioVector));
+
+    assert_not_null(addIoVectorCStr(ioVector, "HTTP/1.1 200 OK\r\n"));
+    assert_not_null(addIoVectorCStr(ioVector, ""));  // empty part does not take vector
+    assert_not_null(addIoVectorView(ioVector, (StringView) {.value = "\r\n\r\n", .length = 2}));
+    assert_null(addIoVectorString(ioVector, NEW_STRING_16("body")));
+    assert_uint32(ioVector->count, ==, 2);
+    assert_uint32(stringIoVectorRemaining(ioVector), ==, 19);
+
+    clearStringIoVector(ioVector);
+    assert_uint32(ioVector->count, ==, 0);
+    assert_null(newStringIoVector(NULL, NULL, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testWriteStringIoVector(const MunitParameter params[], void *testData) {
+    int fds[2];
+    assert_int(pipe(fds), ==, 0);
+
+    BufferString *header = STRING_FORMAT_64("Content-Length: %d\r\n\r\n", 4);
+    StringIoVector *ioVector = NEW_STRING_IO_VECTOR(8);
+    addIoVectorCStr(ioVector, "HTTP/1.1 200 OK\r\n");
+    addIoVectorString(ioVector, header);
+    addIoVectorChars(ioVector, "test trailer", 4);
+
+    assert_int(writeStringIoVector(ioVector, fds[1]), ==, 42);
+    assert_true(isStringIoVectorDone(ioVector));
+    assert_int(writeStringIoVector(ioVector, fds[1]), ==, 0);
+    close(fds[1]);
+
+    char buffer[64] = {0};
+    assert_uint32(readPipe(fds[0], buffer, sizeof(buffer)), ==, 42);
+    assert_string_equal(buffer, "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\ntest");
+    close(fds[0]);
+    return MUNIT_OK;
+}
+
+static MunitResult testPartialWriteStringIoVector(const MunitParameter params[], void *testData) {
+    int fds[2];
+    assert_int(pipe(fds), ==, 0);
+    assert_int(fcntl(fds[1], F_SETFL, O_NONBLOCK), ==, 0);
+
+    static char body[IO_VECTOR_LARGE_BODY_SIZE];
+    static char received[IO_VECTOR_LARGE_BODY_SIZE + 64];
+    for (uint32_t i = 0; i < sizeof(body); i++) {
+        body[i] = (char) ('a' + (i % 26));
+    }
+
+    StringIoVector *ioVector = NEW_STRING_IO_VECTOR(4);
+    addIoVectorCStr(ioVector, "<head>");
+    addIoVectorChars(ioVector, body, sizeof(body));
+    addIoVectorCStr(ioVector, "<tail>");
+    assert_null(writeAllStringIoVector(ioVector, fds[1]));  // pipe is full, should stop on EAGAIN
+    assert_int(errno, ==, EAGAIN);
+    assert_false(isStringIoVectorDone(ioVector));
+
+    uint32_t receivedLength = 0;
+    while (!isStringIoVectorDone(ioVector)) {   // resume after reader drains the pipe
+        ssize_t readLength = read(fds[0], received + receivedLength, sizeof(received) - receivedLength);
+        assert_int(readLength, >, 0);
+        receivedLength += readLength;
+        writeStringIoVector(ioVector, fds[1]);
+    }
+    close(fds[1]);
+    receivedLength += readPipe(fds[0], received + receivedLength, sizeof(received) - receivedLength);
+    close(fds[0]);
+
+    assert_uint32(receivedLength, ==, sizeof(body) + 12);
+    assert_memory_equal(6, received, "<head>");
+    assert_memory_equal(sizeof(body), received + 6, body);
+    assert_memory_equal(6, received + 6 + sizeof(body), "<tail>");
+    return MUNIT_OK;
+}
+
+static MunitResult testSendStringIoVector(const MunitParameter params[], void *testData) {
+    int sockets[2];
+    assert_int(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), ==, 0);
+
+    StringIoVector *ioVector = NEW_STRING_IO_VECTOR(4);
+    addIoVectorCStr(ioVector, "AT+CIPSEND=");
+    addIoVectorString(ioVector, INT64_TO_STRING(4));
+    addIoVectorCStr(ioVector, "\r\n");
+    assert_int(sendStringIoVector(ioVector, sockets[0], 0), ==, 14);
+    close(sockets[0]);
+
+    char buffer[32] = {0};
+    assert_uint32(readPipe(sockets[1], buffer, sizeof(buffer)), ==, 14);
+    assert_string_equal(buffer, "AT+CIPSEND=4\r\n");
+    close(sockets[1]);
+    return MUNIT_OK;
+}
+
+static MunitTest stringIoVectorTests[] = {
+        {.name =  "Test newStringIoVector() - should correctly add string parts", .test = testNewStringIoVector},
+        {.name =  "Test writeStringIoVector() - should write all parts with single call", .test = testWriteStringIoVector},
+        {.name =  "Test writeStringIoVector() - should resume after partial write", .test = testPartialWriteStringIoVector},
+        {.name =  "Test sendStringIoVector() - should send all parts to socket", .test = testSendStringIoVector},
+        END_OF_TESTS
+};
+
+static const MunitSuite stringIoVectorTestSuite = {
+        .prefix = "StringIoVector: ",
+        .tests = stringIoVectorTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
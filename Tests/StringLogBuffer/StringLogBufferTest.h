@@ -0,0 +1,150 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringLogBuffer.h>
+
+#ifdef ENABLE_MULTITHREADING
+#include <sched.h>
+#endif
+
+static bool collectLogRecord(StringView record, void *context) {
+    concatCharsByLength(context, record.value, record.length);
+    concatChar(context, ';');
+    return true;
+}
+
+static MunitResult testNewStringLogBuffer(const MunitParameter params[], void *testData) {
+    StringLogBuffer *log = NEW_STRING_LOG_BUFFER(64);
+    assert_not_null(log);
+    assert_true(isStringLogEmpty(log));
+    assert_uint32(stringLogDroppedCount(log), ==, 0);
+
+    assert_null(NEW_STRING_LOG_BUFFER(48));    // capacity is not power of two
+    assert_null(newStringLogBuffer(NULL, NULL, 64));
+
+    static uint32_t staticBuffer[32] = {0};
+    assert_not_null(NEW_STRING_LOG_BUFFER_BUFF(staticBuffer));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringLogAppendAndDrain(const MunitParameter params[], void *testData) {
+    StringLogBuffer *log = NEW_STRING_LOG_BUFFER(64);
+    assert_not_null(appendLogString(log, STRING_FORMAT_32("worker %d started", 1)));   // 16 chars take 20 bytes
+    assert_not_null(appendLogChars(log, "ping", 4));                                  // 8 bytes
+    assert_not_null(appendLogString(log, STRING_FORMAT_32("worker %d started", 2)));
+    assert_null(appendLogChars(log, "no space at all", 15));
+    assert_uint32(stringLogDroppedCount(log), ==, 1);
+
+    BufferString *output = NEW_STRING_128("");
+    assert_uint32(drainStringLog(log, collectLogRecord, output, 2), ==, 2);
+    assert_string_equal(stringValue(output), "worker 1 started;ping;");
+
+    assert_not_null(appendLogChars(log, "to the start!!", 14));    // 16 bytes left at the end, record wraps
+    assert_uint32(drainStringLog(log, collectLogRecord, output, UINT32_MAX), ==, 2);
+    assert_string_equal(stringValue(output), "worker 1 started;ping;worker 2 started;to the start!!;");
+    assert_true(isStringLogEmpty(log));
+
+    assert_null(appendLogChars(log, "too long record, that is larger than the whole log buffer capacity", 66));
+    assert_null(appendLogString(log, NULL));
+    return MUNIT_OK;
+}
+
+#ifdef ENABLE_MULTITHREADING
+#define LOG_PRODUCER_THREADS 4
+#define LOG_PRODUCER_RECORDS 5000
+
+typedef struct LogProducerContext {
+    StringLogBuffer *log;
+    uint32_t threadId;
+} LogProducerContext;
+
+typedef struct LogSequenceChecker {
+    uint32_t nextSequence[LOG_PRODUCER_THREADS];
+    uint32_t totalCount;
+    bool isValid;
+} LogSequenceChecker;
+
+static void *logProducerThread(void *argument) {
+    LogProducerContext *context = argument;
+    for (uint32_t i = 0; i < LOG_PRODUCER_RECORDS; i++) {
+        BufferString *record = STRING_FORMAT_32("%u:%u", context->threadId, i);   // staged in thread own stack
+        while (appendLogString(context->log, record) == NULL) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static bool checkLogSequence(StringView record, void *context) {
+    LogSequenceChecker *checker = context;
+    char value[32] = {0};
+    memcpy(value, record.value, record.length);
+    char *separator = NULL;
+    uint32_t threadId = strtoul(value, &separator, 10);
+    uint32_t sequence = strtoul(separator + 1, NULL, 10);
+    if (threadId >= LOG_PRODUCER_THREADS || checker->nextSequence[threadId] != sequence) {   // each thread order is kept
+        checker->isValid = false;
+    }
+    checker->nextSequence[threadId]++;
+    checker->totalCount++;
+    return true;
+}
+
+static MunitResult testStringLogConcurrentProducers(const MunitParameter params[], void *testData) {
+    StringLogBuffer *log = NEW_STRING_LOG_BUFFER(512);
+    pthread_t threads[LOG_PRODUCER_THREADS];
+    LogProducerContext contexts[LOG_PRODUCER_THREADS];
+    for (uint32_t i = 0; i < LOG_PRODUCER_THREADS; i++) {
+        contexts[i] = (LogProducerContext) {.log = log, .threadId = i};
+        assert_int(pthread_create(&threads[i], NULL, logProducerThread, &contexts[i]), ==, 0);
+    }
+
+    LogSequenceChecker checker = {.isValid = true};
+    while (checker.totalCount < LOG_PRODUCER_THREADS * LOG_PRODUCER_RECORDS) {
+        if (drainStringLog(log, checkLogSequence, &checker, 16) == 0) {
+            sched_yield();
+        }
+    }
+    for (uint32_t i = 0; i < LOG_PRODUCER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assert_true(checker.isValid);
+    assert_true(isStringLogEmpty(log));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringLogFlusher(const MunitParameter params[], void *testData) {
+    StringLogBuffer *log = NEW_STRING_LOG_BUFFER(256);
+    BufferString *output = NEW_STRING_256("");
+    StringLogFlusher flusher;
+    assert_not_null(startStringLogFlusher(&flusher, log, collectLogRecord, output, 1));
+
+    for (int i = 0; i < 20; i++) {
+        while (appendLogString(log, STRING_FORMAT_16("%d", i)) == NULL);
+    }
+    assert_not_null(stopStringLogFlusher(&flusher));
+    assert_true(isStringLogEmpty(log));
+    assert_string_equal(stringValue(output), "0;1;2;3;4;5;6;7;8;9;10;11;12;13;14;15;16;17;18;19;");
+
+    assert_null(startStringLogFlusher(&flusher, log, NULL, NULL, 1));
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest stringLogBufferTests[] = {
+        {.name =  "Test newStringLogBuffer() - should correctly create new log buffer", .test = testNewStringLogBuffer},
+        {.name =  "Test appendLogString() - should append records and drain them in order", .test = testStringLogAppendAndDrain},
+#ifdef ENABLE_MULTITHREADING
+        {.name =  "Test appendLogString() - should keep records from concurrent producers", .test = testStringLogConcurrentProducers},
+        {.name =  "Test startStringLogFlusher() - should flush all records before stop", .test = testStringLogFlusher},
+#endif
+        END_OF_TESTS
+};
+
+static const MunitSuite stringLogBufferTestSuite = {
+        .prefix = "StringLogBuffer: ",
+        .tests = stringLogBufferTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringMap.h>
+
+static const char *AT_COMMANDS[] = {"AT", "AT+RST", "AT+GMR", "AT+CWMODE", "AT+CWJAP", "AT+CWLAP", "AT+CWQAP", "AT+CIPSTATUS",
+                                    "AT+CIPSTART", "AT+CIPSEND", "AT+CIPCLOSE", "AT+CIFSR", "AT+CIPMUX", "AT+CIPSERVER", "AT+CIPMODE", "AT+CIPSTO"};
+
+static StringView viewOf(const char *str) {
+    return (StringView) {.value = str, .length = strlen(str)};
+}
+
+static MunitResult testNewStringMap(const MunitParameter params[], void *testData) {
+    StringMap *map = NEW_STRING_MAP(16);
+    assert_not_null(map);
+    assert_uint32(stringMapSize(map), ==, 0);
+    assert_uint32(stringMapCapacity(map), ==, 16);
+    assert_true(isStringMapEmpty(map));
+
+    assert_null(NEW_STRING_MAP(12));   // capacity is not power of two
+    assert_null(newStringMap(NULL, NULL, 16));
+
+    static StringMapEntry staticEntries[32] = {0};
+    StringMap *staticMap = NEW_STRING_MAP_BUFF(staticEntries);
+    assert_not_null(staticMap);
+    assert_uint32(stringMapCapacity(staticMap), ==, 32);
+    return MUNIT_OK;
+}
+
+static MunitResult testStringMapPutAndGet(const MunitParameter params[], void *testData) {
+    StringMap *map = NEW_STRING_MAP(32);
+    int handlers[ARRAY_SIZE(AT_COMMANDS)] = {0};
+    for (uint32_t i = 0; i < ARRAY_SIZE(AT_COMMANDS); i++) {
+        assert_not_null(stringMapPutCStr(map, AT_COMMANDS[i], &handlers[i]));
+    }
+    assert_uint32(stringMapSize(map), ==, ARRAY_SIZE(AT_COMMANDS));
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(AT_COMMANDS); i++) {
+        assert_ptr_equal(stringMapGetCStr(map, AT_COMMANDS[i]), &handlers[i]);
+        assert_true(isStringMapContains(map, viewOf(AT_COMMANDS[i])));
+    }
+
+    assert_null(stringMapGetCStr(map, "AT+UNKNOWN"));
+    assert_null(stringMapGetCStr(map, "at"));
+    assert_false(isStringMapContains(map, viewOf("AT+CIP")));
+
+    BufferString *key = NEW_STRING_32("AT+CIPSEND=4");
+    StringView keyPart = {.value = stringValue(key), .length = 10};   // lookup by part of the other string
+    assert_ptr_equal(stringMapGet(map, keyPart), &handlers[9]);
+
+    BufferString *strKey = NEW_STRING_32("AT+CWLAP");
+    assert_ptr_equal(stringMapGetString(map, strKey), &handlers[5]);
+    assert_uint32(strKey->hash, !=, 0);     // hash should be cached in the key string
+
+    int otherValue = 0;
+    stringMapPutString(map, strKey, &otherValue);  // replace existing value
+    assert_uint32(stringMapSize(map), ==, ARRAY_SIZE(AT_COMMANDS));
+    assert_ptr_equal(stringMapGetCStr(map, "AT+CWLAP"), &otherValue);
+
+    assert_null(stringMapPutCStr(NULL, "AT", NULL));
+    assert_null(stringMapPutCStr(map, NULL, NULL));
+    assert_null(stringMapGetString(map, NULL));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringMapFull(const MunitParameter params[], void *testData) {
+    StringMap *map = NEW_STRING_MAP(4);
+    int value = 0;
+    assert_not_null(stringMapPutCStr(map, AT_COMMANDS[0], &value));
+    assert_not_null(stringMapPutCStr(map, AT_COMMANDS[1], &value));
+    assert_not_null(stringMapPutCStr(map, AT_COMMANDS[2], &value));
+    assert_not_null(stringMapPutCStr(map, AT_COMMANDS[3], &value));
+    assert_null(stringMapPutCStr(map, AT_COMMANDS[4], &value));
+    assert_not_null(stringMapPutCStr(map, AT_COMMANDS[3], NULL));  // existing key can be updated
+    assert_uint32(stringMapSize(map), ==, 4);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        assert_true(isStringMapContains(map, viewOf(AT_COMMANDS[i])));
+    }
+    assert_false(isStringMapContains(map, viewOf(AT_COMMANDS[4])));    // should not loop forever on full map
+    return MUNIT_OK;
+}
+
+static MunitResult testStringMapRemove(const MunitParameter params[], void *testData) {
+    StringMap *map = NEW_STRING_MAP(16);
+    int handlers[ARRAY_SIZE(AT_COMMANDS)] = {0};
+    for (uint32_t i = 0; i < ARRAY_SIZE(AT_COMMANDS); i++) {
+        stringMapPutCStr(map, AT_COMMANDS[i], &handlers[i]);
+    }
+    assert_uint32(stringMapSize(map), ==, 16);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(AT_COMMANDS); i += 2) {
+        assert_ptr_equal(stringMapRemove(map, viewOf(AT_COMMANDS[i])), &handlers[i]);
+    }
+    assert_null(stringMapRemove(map, viewOf(AT_COMMANDS[0])));
+    assert_uint32(stringMapSize(map), ==, 8);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(AT_COMMANDS); i++) {   // shifted entries should still be found
+        void *expected = (i % 2 == 0) ? NULL : &handlers[i];
+        assert_ptr_equal(stringMapGetCStr(map, AT_COMMANDS[i]), expected);
+    }
+
+    clearStringMap(map);
+    assert_true(isStringMapEmpty(map));
+    assert_null(stringMapGetCStr(map, AT_COMMANDS[1]));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringMapIterator(const MunitParameter params[], void *testData) {
+    StringMap *map = NEW_STRING_MAP(16);
+    int values[] = {1, 2, 3};
+    stringMapPutCStr(map, "Host", &values[0]);
+    stringMapPutCStr(map, "Connection", &values[1]);
+    stringMapPutCStr(map, "Content-Length", &values[2]);
+
+    int sum = 0;
+    uint32_t count = 0;
+    StringMapIterator iterator = getStringMapIterator(map);
+    while (hasNextMapEntry(&iterator)) {
+        assert_ptr_equal(stringMapGet(map, iterator.key), iterator.value);
+        sum += *(int *) iterator.value;
+        count++;
+    }
+    assert_uint32(count, ==, 3);
+    assert_int(sum, ==, 6);
+
+    StringMapIterator emptyIterator = getStringMapIterator(NULL);
+    assert_false(hasNextMapEntry(&emptyIterator));
+    return MUNIT_OK;
+}
+
+static MunitTest stringMapTests[] = {
+        {.name =  "Test newStringMap() - should correctly create new map", .test = testNewStringMap},
+        {.name =  "Test stringMapPut() - should correctly put and get values by key", .test = testStringMapPutAndGet},
+        {.name =  "Test stringMapPut() - should not overflow full map", .test = testStringMapFull},
+        {.name =  "Test stringMapRemove() - should correctly remove entries", .test = testStringMapRemove},
+        {.name =  "Test map iterator - should iterate all map entries", .test = testStringMapIterator},
+        END_OF_TESTS
+};
+
+static const MunitSuite stringMapTestSuite = {
+        .prefix = "StringMap: ",
+        .tests = stringMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringMatcher.h>
+
+static const char *ESP_MARKERS[] = {"OK", "ERROR", "+IPD", "CONNECT", "CLOSED", "FAIL"};
+
+static StringMatcher *createMarkerMatcher(StringMatcher *matcher, StringMatcherNode *nodes, uint16_t nodeCapacity) {
+    newStringMatcher(matcher, nodes, nodeCapacity);
+    for (uint32_t i = 0; i < ARRAY_SIZE(ESP_MARKERS); i++) {
+        assert_not_null(addMatcherPattern(matcher, ESP_MARKERS[i]));
+    }
+    return compileStringMatcher(matcher);
+}
+
+static MunitResult testNewStringMatcher(const MunitParameter params[], void *testData) {
+    StringMatcher *matcher = NEW_STRING_MATCHER(8);
+    assert_not_null(matcher);
+    assert_null(addMatcherPattern(matcher, ""));
+    assert_null(addMatcherPattern(matcher, NULL));
+    assert_not_null(addMatcherPattern(matcher, "CLOSED"));
+    assert_null(addMatcherPattern(matcher, "CLOSED"));  // duplicate
+    assert_null(addMatcherPattern(matcher, "OK"));  // only one node left
+    assert_not_null(addMatcherPattern(matcher, "CLOSE"));  // prefix does not need new nodes
+    assert_not_null(addMatcherPattern(matcher, "A"));
+    assert_uint16(matcher->patternCount, ==, 3);
+    assert_uint16(matcher->nodeCount, ==, 8);
+
+    assert_null(newStringMatcher(NULL, NULL, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testFindFirstMatch(const MunitParameter params[], void *testData) {
+    StringMatcherNode nodes[64];
+    StringMatcher *matcher = createMarkerMatcher(&(StringMatcher) {0}, nodes, ARRAY_SIZE(nodes));
+
+    StringMatch match = {0};
+    assert_true(findFirstMatch(matcher, NEW_STRING_128("0,CONNECT\n"), &match));
+    assert_uint16(match.patternId, ==, 3);
+    assert_uint32(match.offset, ==, 2);
+    assert_uint32(match.length, ==, 7);
+
+    assert_true(findFirstMatch(matcher, NEW_STRING_128("\n +IPD,1,497:GET /api/test HTTP/1.1 OK"), &match));
+    assert_uint16(match.patternId, ==, 2);
+    assert_uint32(match.offset, ==, 2);
+
+    assert_true(findFirstMatch(matcher, NEW_STRING_128("SEND FAIL"), &match));
+    assert_uint16(match.patternId, ==, 5);
+    assert_false(findFirstMatch(matcher, NEW_STRING_128("busy p..."), &match));
+    assert_false(findFirstMatch(matcher, NEW_STRING_128(""), &match));
+
+    StringMatcher *notCompiled = NEW_STRING_MATCHER(16);
+    addMatcherPattern(notCompiled, "OK");
+    assert_false(findFirstMatch(notCompiled, NEW_STRING_16("OK"), &match));
+    return MUNIT_OK;
+}
+
+static MunitResult testFindLeftmostMatch(const MunitParameter params[], void *testData) {
+    StringMatcher *matcher = NEW_STRING_MATCHER(16);
+    addMatcherPattern(matcher, "abcd");
+    addMatcherPattern(matcher, "bc");
+    addMatcherPattern(matcher, "ab");
+    compileStringMatcher(matcher);
+
+    StringMatch match = {0};
+    assert_true(findFirstMatch(matcher, NEW_STRING_16("abcd"), &match));   // "ab" and "bc" end earlier
+    assert_uint16(match.patternId, ==, 0);
+    assert_uint32(match.offset, ==, 0);
+    assert_uint32(match.length, ==, 4);
+
+    assert_true(findFirstMatch(matcher, NEW_STRING_16("xabcx"), &match));  // "abcd" is not completed
+    assert_uint16(match.patternId, ==, 2);
+    assert_uint32(match.offset, ==, 1);
+    assert_uint32(match.length, ==, 2);
+
+    assert_true(findFirstMatch(matcher, NEW_STRING_16("bcabcd"), &match));
+    assert_uint16(match.patternId, ==, 1);
+    assert_uint32(match.offset, ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testAllMatches(const MunitParameter params[], void *testData) {
+    StringMatcher *matcher = NEW_STRING_MATCHER(32);
+    const char *patterns[] = {"he", "she", "his", "hers"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(patterns); i++) {
+        addMatcherPattern(matcher, patterns[i]);
+    }
+    compileStringMatcher(matcher);
+
+    StringMatch expected[] = {{1, 1, 3}, {0, 2, 2}, {3, 2, 4}, {2, 9, 3}, {1, 13, 3}, {0, 14, 2}};
+    uint32_t count = 0;
+    StringMatchIterator iterator = getBufferStringMatchIterator(matcher, NEW_STRING_32("ushers, this she"));
+    while (hasNextMatch(&iterator)) {
+        assert_true(count < ARRAY_SIZE(expected));
+        assert_uint16(iterator.match.patternId, ==, expected[count].patternId);
+        assert_uint32(iterator.match.offset, ==, expected[count].offset);
+        assert_uint32(iterator.match.length, ==, expected[count].length);
+        count++;
+    }
+    assert_uint32(count, ==, ARRAY_SIZE(expected));
+    return MUNIT_OK;
+}
+
+static MunitResult testStreamingMatches(const MunitParameter params[], void *testData) {
+    StringMatcherNode nodes[64];
+    StringMatcher *matcher = createMarkerMatcher(&(StringMatcher) {0}, nodes, ARRAY_SIZE(nodes));
+    const char *chunks[] = {"0,CONN", "ECT\r\n+I", "P", "D,0,2:OK\r\n0,CLO", "SED\r\n"};
+    uint16_t expectedIds[] = {3, 2, 0, 4};
+    uint32_t expectedOffsets[] = {2, 11, 20, 26};
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < ARRAY_SIZE(chunks); i++) {
+        StringMatchIterator iterator = getStringMatchIterator(matcher, chunks[i], strlen(chunks[i]));
+        while (hasNextMatch(&iterator)) {
+            assert_uint16(iterator.match.patternId, ==, expectedIds[count]);
+            assert_uint32(iterator.match.offset, ==, expectedOffsets[count]);
+            count++;
+        }
+    }
+    assert_uint32(count, ==, ARRAY_SIZE(expectedIds));
+    assert_uint32(matcher->streamOffset, ==, 34);
+
+    resetStringMatcher(matcher);
+    StringMatchIterator iterator = getStringMatchIterator(matcher, "SED\r\n", 5);
+    assert_false(hasNextMatch(&iterator));  // state is dropped after reset
+    return MUNIT_OK;
+}
+
+static MunitTest stringMatcherTests[] = {
+        {.name =  "Test newStringMatcher() - should correctly add patterns", .test = testNewStringMatcher},
+        {.name =  "Test findFirstMatch() - should find first pattern in string", .test = testFindFirstMatch},
+        {.name =  "Test findFirstMatch() - should prefer leftmost start over earlier end", .test = testFindLeftmostMatch},
+        {.name =  "Test hasNextMatch() - should find all overlapping patterns", .test = testAllMatches},
+        {.name =  "Test hasNextMatch() - should find patterns across chunk boundaries", .test = testStreamingMatches},
+        END_OF_TESTS
+};
+
+static const MunitSuite stringMatcherTestSuite = {
+        .prefix = "StringMatcher: ",
+        .tests = stringMatcherTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringReader.h>
+#include <unistd.h>
+
+typedef struct ChunkSource {
+    const char **chunks;
+    uint32_t count;
+    uint32_t index;
+    uint32_t offset;
+} ChunkSource;
+
+static int32_t readNextChunk(char *buffer, uint32_t length, void *context) {
+    ChunkSource *source = context;
+    if (source->index >= source->count) return 0;
+    const char *chunk = source->chunks[source->index] + source->offset;
+    uint32_t chunkLength = strlen(chunk);
+    chunkLength = (chunkLength < length) ? chunkLength : length;
+    memcpy(buffer, chunk, chunkLength);
+    source->offset += chunkLength;
+    if (chunk[chunkLength] == '\0') {   // whole chunk is read
+        source->index++;
+        source->offset = 0;
+    }
+    return (int32_t) chunkLength;
+}
+
+static int32_t readWithError(char *buffer, uint32_t length, void *context) {
+    return -1;
+}
+
+static void assertNextRecord(StringReader *reader, const char *expected) {
+    StringView record = {0};
+    assert_true(hasNextRecord(reader, &record));
+    assert_uint32(record.length, ==, strlen(expected));
+    assert_memory_equal(record.length, record.value, expected);
+}
+
+static MunitResult testStringReaderChunks(const MunitParameter params[], void *testData) {
+    const char *chunks[] = {"0,CONNECT\n 1,CONN", "ECT\n", "\n +IPD,1,497:GET /api/test HTTP/1.1\nHo", "st: 192.168.53.117\nConnection: keep-alive"};
+    ChunkSource source = {.chunks = chunks, .count = ARRAY_SIZE(chunks)};
+    StringReader *reader = NEW_STRING_READER(64, readNextChunk, &source, '\n');
+    assert_not_null(reader);
+
+    assertNextRecord(reader, "0,CONNECT");
+    assertNextRecord(reader, " 1,CONNECT");
+    assertNextRecord(reader, "");
+    assertNextRecord(reader, " +IPD,1,497:GET /api/test HTTP/1.1");
+    assertNextRecord(reader, "Host: 192.168.53.117");
+    assertNextRecord(reader, "Connection: keep-alive");    // last record without delimiter
+
+    StringView record = {0};
+    assert_false(hasNextRecord(reader, &record));
+    assert_int(stringReaderStatus(reader), ==, STRING_READER_END_OF_STREAM);
+    assert_null(NEW_STRING_READER(16, NULL, NULL, '\n'));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringReaderErrors(const MunitParameter params[], void *testData) {
+    const char *chunks[] = {"short;record too long for buffer;", "ok;"};
+    ChunkSource source = {.chunks = chunks, .count = ARRAY_SIZE(chunks)};
+    StringReader *reader = NEW_STRING_READER(40, readNextChunk, &source, ';');
+
+    StringView record = {0};
+    assertNextRecord(reader, "short");
+    assertNextRecord(reader, "record too long for buffer");
+    assertNextRecord(reader, "ok");
+
+    const char *longChunks[] = {"0123456789", "0123456789", "a;"};
+    ChunkSource longSource = {.chunks = longChunks, .count = ARRAY_SIZE(longChunks)};
+    StringReader *smallReader = NEW_STRING_READER(16, readNextChunk, &longSource, ';');
+    assert_false(hasNextRecord(smallReader, &record));
+    assert_int(stringReaderStatus(smallReader), ==, STRING_READER_OVERFLOW);
+    assert_false(hasNextRecord(smallReader, &record));  // tail "a" of the long record is skipped
+    assert_int(stringReaderStatus(smallReader), ==, STRING_READER_END_OF_STREAM);
+
+    const char *tailChunks[] = {"first;0123456789abcdef", "0123456789", "0123;next;", "last"};
+    ChunkSource tailSource = {.chunks = tailChunks, .count = ARRAY_SIZE(tailChunks)};
+    StringReader *tailReader = NEW_STRING_READER(16, readNextChunk, &tailSource, ';');
+    assertNextRecord(tailReader, "first");
+    assert_false(hasNextRecord(tailReader, &record));
+    assert_int(stringReaderStatus(tailReader), ==, STRING_READER_OVERFLOW);
+    assertNextRecord(tailReader, "next");   // not the rest of the long record
+    assertNextRecord(tailReader, "last");
+
+    StringReader *errorReader = NEW_STRING_READER(16, readWithError, NULL, ';');
+    assert_false(hasNextRecord(errorReader, &record));
+    assert_int(stringReaderStatus(errorReader), ==, STRING_READER_READ_ERROR);
+    return MUNIT_OK;
+}
+
+#ifdef ENABLE_POSIX_IO
+static MunitResult testFdStringReaderPipe(const MunitParameter params[], void *testData) {
+    int fds[2];
+    assert_int(pipe(fds), ==, 0);
+    const char *input = "+CWLAP:(3,\"CVBJB\",-71)\r\n+CWLAP:(2,\"AllSaints\",-88)\r\nOK\r\n";
+    assert_int(write(fds[1], input, strlen(input)), ==, strlen(input));
+    close(fds[1]);
+
+    StringReader *reader = NEW_FD_STRING_READER(32, fds[0], '\n');
+    assertNextRecord(reader, "+CWLAP:(3,\"CVBJB\",-71)\r");
+    assertNextRecord(reader, "+CWLAP:(2,\"AllSaints\",-88)\r");
+    assertNextRecord(reader, "OK\r");
+
+    StringView record = {0};
+    assert_false(hasNextRecord(reader, &record));
+    assert_int(stringReaderStatus(reader), ==, STRING_READER_END_OF_STREAM);
+    close(fds[0]);
+    return MUNIT_OK;
+}
+
+static MunitResult testFdStringReaderFile(const MunitParameter params[], void *testData) {
+    FILE *file = tmpfile();
+    assert_not_null(file);
+    for (int i = 0; i < 1000; i++) {
+        fprintf(file, "line %d\n", i);
+    }
+    fflush(file);
+    rewind(file);
+
+    StringReader *reader = NEW_FD_STRING_READER(64, fileno(file), '\n');
+    StringView record = {0};
+    int lineCount = 0;
+    while (hasNextRecord(reader, &record)) {
+        BufferString *expected = STRING_FORMAT_16("line %d", lineCount);
+        assert_uint32(record.length, ==, stringLength(expected));
+        assert_memory_equal(record.length, record.value, stringValue(expected));
+        lineCount++;
+    }
+    assert_int(lineCount, ==, 1000);
+    assert_int(stringReaderStatus(reader), ==, STRING_READER_END_OF_STREAM);
+    fclose(file);
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest stringReaderTests[] = {
+        {.name =  "Test hasNextRecord() - should split chunked input to records", .test = testStringReaderChunks},
+        {.name =  "Test hasNextRecord() - should report overflow and read errors", .test = testStringReaderErrors},
+#ifdef ENABLE_POSIX_IO
+        {.name =  "Test hasNextRecord() - should read lines from pipe", .test = testFdStringReaderPipe},
+        {.name =  "Test hasNextRecord() - should read lines from file", .test = testFdStringReaderFile},
+#endif
+        END_OF_TESTS
+};
+
+static const MunitSuite stringReaderTestSuite = {
+        .prefix = "StringReader: ",
+        .tests = stringReaderTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <StringRingBuffer.h>
+
+#ifdef ENABLE_MULTITHREADING
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+typedef struct RingRecordCollector {
+    BufferString *output;
+    uint32_t count;
+    uint32_t stopAfter;
+} RingRecordCollector;
+
+static bool collectRingRecord(StringView record, void *context) {
+    RingRecordCollector *collector = context;
+    if (collector->stopAfter > 0 && collector->count >= collector->stopAfter) return false;
+    concatCharsByLength(collector->output, record.value, record.length);
+    concatChar(collector->output, ';');
+    collector->count++;
+    return true;
+}
+
+static MunitResult testNewStringRingBuffer(const MunitParameter params[], void *testData) {
+    StringRingBuffer *ring = NEW_STRING_RING_BUFFER(64);
+    assert_not_null(ring);
+    assert_true(isStringRingEmpty(ring));
+
+    assert_null(NEW_STRING_RING_BUFFER(30));   // not aligned to record size
+    assert_null(newStringRingBuffer(NULL, NULL, 64));
+
+    static char staticBuffer[128] = {0};
+    assert_not_null(NEW_STRING_RING_BUFFER_BUFF(staticBuffer));
+    return MUNIT_OK;
+}
+
+static MunitResult testStringRingReserveAndCommit(const MunitParameter params[], void *testData) {
+    StringRingBuffer *ring = NEW_STRING_RING_BUFFER(128);
+    for (int i = 0; i < 3; i++) {
+        BufferString *slot = reserveRingString(ring, &(BufferString){0}, 32);
+        assert_not_null(slot);
+        assert_not_null(stringFormat(slot, "record %d: %s", i, "ok"));
+        assert_not_null(commitRingString(ring, slot));
+    }
+    assert_false(isStringRingEmpty(ring));
+
+    BufferString *notCommitted = reserveRingString(ring, &(BufferString){0}, 32);   // should not be visible for consumer
+    stringFormat(notCommitted, "lost");
+
+    RingRecordCollector collector = {.output = NEW_STRING_128("")};
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 3);
+    assert_string_equal(stringValue(collector.output), "record 0: ok;record 1: ok;record 2: ok;");
+    assert_true(isStringRingEmpty(ring));
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 0);
+
+    assert_null(reserveRingString(ring, &(BufferString){0}, 128));    // record can't be larger than the ring
+    assert_null(commitRingString(ring, NEW_STRING_16("other")));    // not reserved string
+    return MUNIT_OK;
+}
+
+static MunitResult testStringRingFullAndWrap(const MunitParameter params[], void *testData) {
+    StringRingBuffer *ring = NEW_STRING_RING_BUFFER(64);   // each 11 char record takes 16 bytes
+    BufferString *slot = NULL;
+    for (int i = 0; i < 3; i++) {
+        slot = reserveRingString(ring, &(BufferString){0}, 11);
+        assert_not_null(slot);
+        stringFormat(slot, "message #%d%d", 0, i);
+        commitRingString(ring, slot);
+    }
+    assert_null(reserveRingString(ring, &(BufferString){0}, 11));     // one record is kept free between head and tail
+
+    RingRecordCollector collector = {.output = NEW_STRING_128(""), .stopAfter = 2};
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 2);     // consumer stopped, third record is kept
+    assert_string_equal(stringValue(collector.output), "message #00;message #01;");
+
+    slot = reserveRingString(ring, &(BufferString){0}, 20);     // does not fit at the end, wraps to the start
+    assert_not_null(slot);
+    stringFormat(slot, "wrapped %d", 3);
+    commitRingString(ring, slot);
+    slot = reserveRingString(ring, &(BufferString){0}, 11);     // would overwrite unread record
+    assert_null(slot);
+
+    clearString(collector.output);
+    collector.count = 0;
+    collector.stopAfter = 0;
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, 1), ==, 1);     // batch limit
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, 1), ==, 1);
+    assert_string_equal(stringValue(collector.output), "message #02;wrapped 3;");
+    assert_true(isStringRingEmpty(ring));
+
+    slot = reserveRingString(ring, &(BufferString){0}, 11);
+    stringFormat(slot, "message #04");
+    commitRingString(ring, slot);
+    clearString(collector.output);
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 1);
+    assert_string_equal(stringValue(collector.output), "message #04;");
+    return MUNIT_OK;
+}
+
+static MunitResult testStringRingReusedSlot(const MunitParameter params[], void *testData) {
+    StringRingBuffer *ring = NEW_STRING_RING_BUFFER(64);
+    BufferString *slot = reserveRingString(ring, &(BufferString){0}, 30);   // 36 bytes at the ring start
+    stringFormat(slot, "long record with old content %d", 1);
+    commitRingString(ring, slot);
+    RingRecordCollector collector = {.output = NEW_STRING_128("")};
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 1);
+
+    slot = reserveRingString(ring, &(BufferString){0}, 24);     // does not fit at the end, placed over the old record
+    assert_not_null(slot);
+    assert_ptr_equal(slot->value, ring->buffer + 4);
+    stringFormat(slot, "short %d", 2);
+    assert_string_equal(stringValue(slot), "short 2");
+    for (uint32_t i = slot->length; i < slot->capacity; i++) {
+        assert_char(slot->value[i], ==, '\0');
+    }
+    commitRingString(ring, slot);
+
+    clearString(collector.output);
+    assert_uint32(drainStringRing(ring, collectRingRecord, &collector, UINT32_MAX), ==, 1);
+    assert_string_equal(stringValue(collector.output), "short 2;");
+    return MUNIT_OK;
+}
+
+#ifdef ENABLE_MULTITHREADING
+#define RING_PRODUCER_RECORDS 20000
+
+static void *ringProducerThread(void *argument) {
+    StringRingBuffer *ring = argument;
+    for (uint32_t i = 0; i < RING_PRODUCER_RECORDS; i++) {
+        BufferString slotString;    // compound literal in the loop condition would end its lifetime with the loop
+        BufferString *slot;
+        while ((slot = reserveRingString(ring, &slotString, 24)) == NULL) {   // wait until consumer frees space
+            sched_yield();
+        }
+        stringFormat(slot, "%u", i);
+        commitRingString(ring, slot);
+    }
+    return NULL;
+}
+
+static bool checkRingSequence(StringView record, void *context) {
+    uint32_t *expected = context;
+    char value[16] = {0};
+    memcpy(value, record.value, record.length);
+    if ((uint32_t) strtoul(value, NULL, 10) != *expected) return false;
+    (*expected)++;
+    return true;
+}
+
+static MunitResult testStringRingConcurrent(const MunitParameter params[], void *testData) {
+    StringRingBuffer *ring = NEW_STRING_RING_BUFFER(256);
+    pthread_t producer;
+    assert_int(pthread_create(&producer, NULL, ringProducerThread, ring), ==, 0);
+
+    uint32_t expected = 0;
+    while (expected < RING_PRODUCER_RECORDS) {
+        uint32_t before = expected;
+        if (drainStringRing(ring, checkRingSequence, &expected, 8) == 0) {
+            sched_yield();
+        }
+        assert_true(expected >= before);
+    }
+    pthread_join(producer, NULL);
+    assert_uint32(expected, ==, RING_PRODUCER_RECORDS);
+    assert_true(isStringRingEmpty(ring));
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest stringRingBufferTests[] = {
+        {.name =  "Test newStringRingBuffer() - should correctly create new ring", .test = testNewStringRingBuffer},
+        {.name =  "Test reserveRingString() - should format into slot and publish on commit", .test = testStringRingReserveAndCommit},
+        {.name =  "Test reserveRingString() - should not overwrite unread records and wrap to start", .test = testStringRingFullAndWrap},
+        {.name =  "Test reserveRingString() - should clear slot placed over consumed record", .test = testStringRingReusedSlot},
+#ifdef ENABLE_MULTITHREADING
+        {.name =  "Test drainStringRing() - should receive records in order from producer thread", .test = testStringRingConcurrent},
+#endif
+        END_OF_TESTS
+};
+
+static const MunitSuite stringRingBufferTestSuite = {
+        .prefix = "StringRingBuffer: ",
+        .tests = stringRingBufferTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
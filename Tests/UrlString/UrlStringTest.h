@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <UrlString.h>
+
+static MunitResult testUrlEncode(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_128("/api/test?q=");
+    const char *query = "a b&c=d/é~._-";
+    assert_not_null(urlEncode(str, query, strlen(query), false));
+    assert_string_equal(stringValue(str), "/api/test?q=a%20b%26c%3Dd%2F%C3%A9~._-");
+
+    BufferString *form = EMPTY_STRING(64);
+    assert_not_null(urlEncode(form, "key word+1", 10, true));
+    assert_string_equal(stringValue(form), "key+word%2B1");
+
+    BufferString *binary = EMPTY_STRING(16);
+    assert_not_null(urlEncode(binary, "\0\xFF", 2, false));
+    assert_string_equal(stringValue(binary), "%00%FF");
+
+    BufferString *small = NEW_STRING_16("abc");
+    assert_null(urlEncode(small, "a b c d", 7, false));  // 16 chars would need 17 bytes with terminator
+    assert_string_equal(stringValue(small), "abc");      // not changed on overflow
+    assert_not_null(urlEncode(small, "a b c", 5, false));
+    assert_uint32(small->length, ==, 12);
+
+    assert_null(urlEncode(NULL, "a", 1, false));
+    assert_null(urlEncode(str, NULL, 0, false));
+    return MUNIT_OK;
+}
+
+static MunitResult testUrlDecode(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_64("name=");
+    const char *encoded = "J%C3%B6rg+M%c3%bcller%21";
+    assert_not_null(urlDecode(str, encoded, strlen(encoded), true));
+    assert_string_equal(stringValue(str), "name=Jörg Müller!");
+
+    BufferString *path = EMPTY_STRING(32);
+    assert_not_null(urlDecode(path, "a+b%2Bc", 7, false));
+    assert_string_equal(stringValue(path), "a+b+c");     // plus is kept without form encoding
+
+    BufferString *invalid = NEW_STRING_16("x");
+    assert_null(urlDecode(invalid, "a%2", 3, false));
+    assert_null(urlDecode(invalid, "a%zz", 4, false));
+    assert_null(urlDecode(NEW_STRING_16("0123456789abc"), "%41%42%43", 9, false));
+    assert_string_equal(stringValue(invalid), "x");
+    return MUNIT_OK;
+}
+
+static MunitResult testUrlDecodeString(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_64("GET /api/test%3Fid%3D42+x HTTP/1.1");
+    assert_not_null(urlDecodeString(str, true));
+    assert_string_equal(stringValue(str), "GET /api/test?id=42 x HTTP/1.1");
+    assert_uint32(str->length, ==, strlen("GET /api/test?id=42 x HTTP/1.1"));
+
+    BufferString *plain = NEW_STRING_16("plain");
+    assert_ptr_equal(urlDecodeString(plain, true), plain);
+    assert_string_equal(stringValue(plain), "plain");
+
+    BufferString *invalid = NEW_STRING_16("a%41%4");
+    assert_null(urlDecodeString(invalid, false));
+    assert_string_equal(stringValue(invalid), "a%41%4");    // validated before decoding
+    assert_null(urlDecodeString(NULL, false));
+    return MUNIT_OK;
+}
+
+static MunitTest urlStringTests[] = {
+        {.name =  "Test urlEncode() - should percent-encode reserved chars", .test = testUrlEncode},
+        {.name =  "Test urlDecode() - should append decoded value", .test = testUrlDecode},
+        {.name =  "Test urlDecodeString() - should decode in place", .test = testUrlDecodeString},
+        END_OF_TESTS
+};
+
+static const MunitSuite urlStringTestSuite = {
+        .prefix = "UrlString: ",
+        .tests = urlStringTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
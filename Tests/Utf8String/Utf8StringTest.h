@@ -0,0 +1,213 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include <Utf8String.h>
+
+static MunitResult testIsValidUtf8(const MunitParameter params[], void *testData) {
+    assert_true(isValidUtf8(NEW_STRING_16("")));
+    assert_true(isValidUtf8(NEW_STRING_64("Plain ASCII SSID: Home-WiFi_5G")));
+    assert_true(isValidUtf8(NEW_STRING_64("Кофейня \xC2\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80")));   // 2, 3 and 4 byte sequences
+    assert_true(isValidUtf8(NEW_STRING_16("\xEF\xBF\xBF\xF4\x8F\xBF\xBF")));    // U+FFFF and U+10FFFF
+    assert_true(isValidUtf8(NEW_STRING_LEN(16, "a\0b", 3)));     // null is valid code point
+    assert_false(isValidUtf8(NULL));
+
+    assert_false(isValidUtf8(NEW_STRING_16("\xC0\xAF")));   // overlong '/'
+    assert_false(isValidUtf8(NEW_STRING_16("\xE0\x80\xAF")));
+    assert_false(isValidUtf8(NEW_STRING_16("\xF0\x80\x80\xAF")));
+    assert_false(isValidUtf8(NEW_STRING_16("\xED\xA0\x80")));   // surrogate U+D800
+    assert_false(isValidUtf8(NEW_STRING_16("\xF4\x90\x80\x80")));   // above U+10FFFF
+    assert_false(isValidUtf8(NEW_STRING_16("\xF5\x80\x80\x80")));
+    assert_false(isValidUtf8(NEW_STRING_16("\x80")));   // continuation byte without lead
+    assert_false(isValidUtf8(NEW_STRING_16("\xE2\x82")));   // truncated
+    assert_false(isValidUtf8(NEW_STRING_16("\xE2\x28\xA1")));
+    return MUNIT_OK;
+}
+
+static MunitResult testIndexOfInvalidUtf8(const MunitParameter params[], void *testData) {
+    assert_int32(indexOfInvalidUtf8(NEW_STRING_32("valid \xC3\xA9t\xC3\xA9")), ==, -1);
+    assert_int32(indexOfInvalidUtf8(NEW_STRING_32("ab\xC3\xA9\xFF")), ==, 4);
+    assert_int32(indexOfInvalidUtf8(NEW_STRING_32("abc\xE2\x82")), ==, 3);     // points to the sequence start
+    assert_int32(indexOfInvalidUtf8(NULL), ==, -1);
+    assert_int32(indexOfInvalidUtf8Chars("\xC3\xA9\xC3", 2), ==, -1);
+
+    char longText[300];
+    for (uint32_t invalidIndex = 0; invalidIndex < 70; invalidIndex++) {    // invalid byte at every position of the word checks
+        memset(longText, 'x', sizeof(longText));
+        longText[invalidIndex] = (char) 0xFE;
+        assert_int32(indexOfInvalidUtf8Chars(longText, sizeof(longText)), ==, invalidIndex);
+    }
+
+    memset(longText, 'x', sizeof(longText));
+    memcpy(&longText[100], "\xF0\x9F\x98\x80", 4);
+    memcpy(&longText[250], "\xF0\x9F\x98", 3);
+    assert_int32(indexOfInvalidUtf8Chars(longText, sizeof(longText)), ==, 250);
+    return MUNIT_OK;
+}
+
+static int32_t indexOfInvalidUtf8Reference(const uint8_t *data, uint32_t length) {
+    for (uint32_t i = 0; i < length;) {
+        uint8_t leadByte = data[i];
+        uint32_t sequenceLength = 1;
+        uint8_t secondMin = 0x80;
+        uint8_t secondMax = 0xBF;
+        if (leadByte >= 0xC2 && leadByte <= 0xDF) {
+            sequenceLength = 2;
+        } else if (leadByte >= 0xE0 && leadByte <= 0xEF) {
+            sequenceLength = 3;
+            secondMin = (leadByte == 0xE0) ? 0xA0 : 0x80;
+            secondMax = (leadByte == 0xED) ? 0x9F : 0xBF;
+        } else if (leadByte >= 0xF0 && leadByte <= 0xF4) {
+            sequenceLength = 4;
+            secondMin = (leadByte == 0xF0) ? 0x90 : 0x80;
+            secondMax = (leadByte == 0xF4) ? 0x8F : 0xBF;
+        } else if (leadByte >= 0x80) {
+            return (int32_t) i;
+        }
+
+        if (length - i < sequenceLength) return (int32_t) i;
+        if (sequenceLength > 1 && (data[i + 1] < secondMin || data[i + 1] > secondMax)) return (int32_t) i;
+        for (uint32_t k = 2; k < sequenceLength; k++) {
+            if ((data[i + k] & 0xC0) != 0x80) return (int32_t) i;
+        }
+        i += sequenceLength;
+    }
+    return -1;
+}
+
+static MunitResult testIndexOfInvalidUtf8Blocks(const MunitParameter params[], void *testData) {
+    const char *pieces[] = {"a", "bc", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF", "\xF4\x8F\xBF\xBF",
+                            "\xE0\xA0\x80", "\xF0\x90\x80\x80", "0123456789abcdef"};
+    const uint8_t invalidBytes[] = {0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xE0, 0xED, 0xF0, 0xF4, 0xF5, 0xFF, 0xA0, 0x90, 0x8F};
+    uint8_t data[160];
+    uint32_t seed = 42;
+    for (uint32_t iteration = 0; iteration < 20000; iteration++) {  // mixed sequences cross 16 byte block boundaries
+        uint32_t length = 0;
+        seed = seed * 1103515245 + 12345;
+        uint32_t targetLength = (seed >> 16) % 140;
+        while (length < targetLength) {
+            seed = seed * 1103515245 + 12345;
+            const char *piece = pieces[(seed >> 16) % ARRAY_SIZE(pieces)];
+            memcpy(data + length, piece, strlen(piece));
+            length += strlen(piece);
+        }
+        for (uint32_t i = 0; i < iteration % 3 && length > 0; i++) {
+            seed = seed * 1103515245 + 12345;
+            data[(seed >> 8) % length] = invalidBytes[(seed >> 16) % sizeof(invalidBytes)];
+        }
+        assert_int32(indexOfInvalidUtf8Chars((const char *) data, length), ==, indexOfInvalidUtf8Reference(data, length));
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testUtf8Length(const MunitParameter params[], void *testData) {
+    assert_uint32(utf8Length(NEW_STRING_16("")), ==, 0);
+    assert_uint32(utf8Length(NEW_STRING_64("plain ascii")), ==, 11);
+    assert_uint32(utf8Length(NEW_STRING_64("Кофейня")), ==, 7);
+    assert_uint32(utf8Length(NEW_STRING_64("Wi-Fi \xF0\x9F\x93\xB6 Café Кафе")), ==, 17);
+    assert_uint32(utf8Length(NULL), ==, 0);
+    assert_uint32(utf8LengthChars("\xE2\x82\xAC\xE2\x82\xAC", 3), ==, 1);
+
+    // invalid runs of continuation bytes are split by 4 bytes like in the iterator, also across 8 byte words
+    const char *invalid = "abcdef\xC3\x80\x80\x80\x80\x80\x80\x80\x80\x80" "ab\x80\x80";
+    BufferString *invalidStr = NEW_STRING_32(invalid);
+    uint32_t iteratorCount = 0;
+    Utf8Iterator iterator = getUtf8Iterator(invalidStr);
+    while (hasNextCodePoint(&iterator)) {
+        assert_int32(utf8OffsetOf(invalidStr, iteratorCount), ==, iterator.codePointOffset);
+        iteratorCount++;
+    }
+    assert_uint32(utf8Length(invalidStr), ==, iteratorCount);
+    assert_uint32(iteratorCount, ==, 11);
+    return MUNIT_OK;
+}
+
+static MunitResult testUtf8Iterator(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_32("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xFF!");
+    uint32_t expectedCodePoints[] = {'a', 0xE9, 0x20AC, 0x1F600, UTF8_REPLACEMENT_CHARACTER, '!'};
+    uint32_t expectedOffsets[] = {0, 1, 3, 6, 10, 11};
+    uint32_t count = 0;
+
+    Utf8Iterator iterator = getUtf8Iterator(str);
+    while (hasNextCodePoint(&iterator)) {
+        assert_uint32(iterator.codePoint, ==, expectedCodePoints[count]);
+        assert_uint32(iterator.codePointOffset, ==, expectedOffsets[count]);
+        count++;
+    }
+    assert_uint32(count, ==, ARRAY_SIZE(expectedCodePoints));
+
+    Utf8Iterator emptyIterator = getUtf8Iterator(NULL);
+    assert_false(hasNextCodePoint(&emptyIterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testUtf8Substring(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_64("Привет, мир!");
+    assert_string_equal(stringValue(UTF8_SUBSTRING(32, str, 0, 6)), "Привет");
+    assert_string_equal(stringValue(UTF8_SUBSTRING(32, str, 8, 12)), "мир!");
+    assert_string_equal(stringValue(UTF8_SUBSTRING(32, str, 12, 12)), "");
+    assert_null(UTF8_SUBSTRING(32, str, 8, 13));
+    assert_null(UTF8_SUBSTRING(32, str, 5, 4));
+
+    assert_int32(utf8OffsetOf(str, 7), ==, 13);
+    assert_int32(utf8OffsetOf(str, 12), ==, str->length);
+    assert_int32(utf8OffsetOf(str, 13), ==, -1);
+    assert_uint32(utf8CodePointAt(str, 8), ==, 0x43C);  // 'м'
+    assert_uint32(utf8CodePointAt(str, 12), ==, 0);
+
+    BufferString *longStr = NEW_STRING_256("");
+    for (uint32_t i = 0; i < 40; i++) {
+        concatChars(longStr, (i % 3 == 0) ? "\xE2\x82\xAC" : (i % 3 == 1) ? "x" : "\xC3\xA9");
+    }
+    for (uint32_t i = 0; i < 40; i++) {    // word counting should stop on the right sequence
+        uint32_t expectedCodePoint = (i % 3 == 0) ? 0x20AC : (i % 3 == 1) ? 'x' : 0xE9;
+        assert_uint32(utf8CodePointAt(longStr, i), ==, expectedCodePoint);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testReverseUtf8String(const MunitParameter params[], void *testData) {
+    assert_string_equal(stringValue(reverseUtf8String(NEW_STRING_32("abc"))), "cba");
+    assert_string_equal(stringValue(reverseUtf8String(NEW_STRING_32("Café €"))), "€ éfaC");
+    assert_string_equal(stringValue(reverseUtf8String(NEW_STRING_32("Кот \xF0\x9F\x98\x80"))), "\xF0\x9F\x98\x80 тоК");
+    assert_null(reverseUtf8String(NULL));
+    return MUNIT_OK;
+}
+
+static MunitResult testUtf8IndexCache(const MunitParameter params[], void *testData) {
+    BufferString *str = NEW_STRING_512("");
+    for (uint32_t i = 0; i < 100; i++) {
+        concatChars(str, (i % 2 == 0) ? "ж" : "z");
+    }
+
+    Utf8IndexCache *cache = NEW_UTF8_INDEX_CACHE(8, str);
+    assert_not_null(cache);
+    assert_uint32(cache->length, ==, 100);
+    for (uint32_t i = 0; i <= 100; i++) {
+        assert_int32(utf8CachedOffsetOf(cache, i), ==, utf8OffsetOf(str, i));
+    }
+    assert_int32(utf8CachedOffsetOf(cache, 101), ==, -1);
+
+    Utf8IndexCache *emptyCache = NEW_UTF8_INDEX_CACHE(4, NEW_STRING_16(""));
+    assert_int32(utf8CachedOffsetOf(emptyCache, 0), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitTest utf8StringTests[] = {
+        {.name =  "Test isValidUtf8() - should validate UTF-8 sequences", .test = testIsValidUtf8},
+        {.name =  "Test indexOfInvalidUtf8() - should return first invalid sequence start", .test = testIndexOfInvalidUtf8},
+        {.name =  "Test indexOfInvalidUtf8Chars() - should match scalar validation on mixed multibyte input", .test = testIndexOfInvalidUtf8Blocks},
+        {.name =  "Test utf8Length() - should count code points", .test = testUtf8Length},
+        {.name =  "Test hasNextCodePoint() - should decode all code points", .test = testUtf8Iterator},
+        {.name =  "Test utf8Substring() - should substring by code point indexes", .test = testUtf8Substring},
+        {.name =  "Test reverseUtf8String() - should keep multibyte sequences", .test = testReverseUtf8String},
+        {.name =  "Test utf8CachedOffsetOf() - should return the same offsets as without cache", .test = testUtf8IndexCache},
+        END_OF_TESTS
+};
+
+static const MunitSuite utf8StringTestSuite = {
+        .prefix = "Utf8String: ",
+        .tests = utf8StringTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -1,8 +1,47 @@
 #include "BufferString/BufferStringTest.h"
+#include "StringMap/StringMapTest.h"
+#include "StringIntern/StringInternTest.h"
+#include "StringMatcher/StringMatcherTest.h"
+#include "StringIoVector/StringIoVectorTest.h"
+#include "StringReader/StringReaderTest.h"
+#include "MappedString/MappedStringTest.h"
+#include "StringRingBuffer/StringRingBufferTest.h"
+#include "StringLogBuffer/StringLogBufferTest.h"
+#include "DeferredFormat/DeferredFormatTest.h"
+#include "BinaryLog/BinaryLogTest.h"
+#include "StringBatch/StringBatchTest.h"
+#include "Utf8String/Utf8StringTest.h"
+#include "JsonString/JsonStringTest.h"
+#include "JsonWriter/JsonWriterTest.h"
+#include "UrlString/UrlStringTest.h"
+#include "HttpRequest/HttpRequestTest.h"
+#include "BinaryEncoding/BinaryEncodingTest.h"
+#include "GlobPattern/GlobPatternTest.h"
 
 int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
     MunitTest emptyTests[] = {END_OF_TESTS};
-    MunitSuite testSuitArray[] = {bufferStringTestSuite};
+    MunitSuite testSuitArray[] = {
+            bufferStringTestSuite,
+            stringMapTestSuite,
+            stringInternTestSuite,
+            stringMatcherTestSuite,
+            stringIoVectorTestSuite,
+            stringReaderTestSuite,
+            mappedStringTestSuite,
+            stringRingBufferTestSuite,
+            stringLogBufferTestSuite,
+            deferredFormatTestSuite,
+            binaryLogTestSuite,
+            stringBatchTestSuite,
+            utf8StringTestSuite,
+            jsonStringTestSuite,
+            jsonWriterTestSuite,
+            urlStringTestSuite,
+            httpRequestTestSuite,
+            binaryEncodingTestSuite,
+            globPatternTestSuite,
+            END_OF_SUITES
+    };
 
     MunitSuite baseSuite = {
             .prefix = "",
@@ -0,0 +1,124 @@
+#include "UrlString.h"
+
+#define STRING_END(s) ((s)->value + (s)->length)
+#define INVALID_URL_LENGTH UINT32_MAX
+#define HEX_DIGITS "0123456789ABCDEF"
+
+#define URL_HEX_VALUE_MASK 0x0F
+#define URL_HEX_DIGIT 0x10
+#define URL_UNRESERVED 0x20
+#define HEX(value) (URL_UNRESERVED | URL_HEX_DIGIT | (value))
+#define IS_URL_HEX_DIGIT(urlChar) ((URL_CHAR_CLASSES[(uint8_t) (urlChar)] & URL_HEX_DIGIT) != 0)
+#define IS_URL_UNRESERVED(urlChar) ((URL_CHAR_CLASSES[(uint8_t) (urlChar)] & URL_UNRESERVED) != 0)
+#define URL_HEX_VALUE(urlChar) (URL_CHAR_CLASSES[(uint8_t) (urlChar)] & URL_HEX_VALUE_MASK)
+
+// single lookup per byte for both encoding and decoding, hex digits keep their value in the low nibble
+static const uint8_t URL_CHAR_CLASSES[256] = {
+        ['0'] = HEX(0), ['1'] = HEX(1), ['2'] = HEX(2), ['3'] = HEX(3), ['4'] = HEX(4),
+        ['5'] = HEX(5), ['6'] = HEX(6), ['7'] = HEX(7), ['8'] = HEX(8), ['9'] = HEX(9),
+        ['A'] = HEX(10), ['B'] = HEX(11), ['C'] = HEX(12), ['D'] = HEX(13), ['E'] = HEX(14), ['F'] = HEX(15),
+        ['a'] = HEX(10), ['b'] = HEX(11), ['c'] = HEX(12), ['d'] = HEX(13), ['e'] = HEX(14), ['f'] = HEX(15),
+        ['G'] = URL_UNRESERVED, ['H'] = URL_UNRESERVED, ['I'] = URL_UNRESERVED, ['J'] = URL_UNRESERVED, ['K'] = URL_UNRESERVED,
+        ['L'] = URL_UNRESERVED, ['M'] = URL_UNRESERVED, ['N'] = URL_UNRESERVED, ['O'] = URL_UNRESERVED, ['P'] = URL_UNRESERVED,
+        ['Q'] = URL_UNRESERVED, ['R'] = URL_UNRESERVED, ['S'] = URL_UNRESERVED, ['T'] = URL_UNRESERVED, ['U'] = URL_UNRESERVED,
+        ['V'] = URL_UNRESERVED, ['W'] = URL_UNRESERVED, ['X'] = URL_UNRESERVED, ['Y'] = URL_UNRESERVED, ['Z'] = URL_UNRESERVED,
+        ['g'] = URL_UNRESERVED, ['h'] = URL_UNRESERVED, ['i'] = URL_UNRESERVED, ['j'] = URL_UNRESERVED, ['k'] = URL_UNRESERVED,
+        ['l'] = URL_UNRESERVED, ['m'] = URL_UNRESERVED, ['n'] = URL_UNRESERVED, ['o'] = URL_UNRESERVED, ['p'] = URL_UNRESERVED,
+        ['q'] = URL_UNRESERVED, ['r'] = URL_UNRESERVED, ['s'] = URL_UNRESERVED, ['t'] = URL_UNRESERVED, ['u'] = URL_UNRESERVED,
+        ['v'] = URL_UNRESERVED, ['w'] = URL_UNRESERVED, ['x'] = URL_UNRESERVED, ['y'] = URL_UNRESERVED, ['z'] = URL_UNRESERVED,
+        ['-'] = URL_UNRESERVED, ['.'] = URL_UNRESERVED, ['_'] = URL_UNRESERVED, ['~'] = URL_UNRESERVED,
+};
+
+static uint32_t urlEncodedLength(const char *value, uint32_t length, bool isFormEncoding);
+static uint32_t urlDecodedLength(const char *value, uint32_t length);
+static uint32_t decodeUrlChars(const char *value, uint32_t length, char *output, bool isFormEncoding);
+
+
+BufferString *urlEncode(BufferString *str, const char *value, uint32_t length, bool isFormEncoding) {
+    if (str == NULL || value == NULL) return NULL;
+    uint32_t encodedLength = urlEncodedLength(value, length, isFormEncoding);
+    if (encodedLength >= str->capacity - str->length) return NULL;    // checked before any write
+
+    char *output = STRING_END(str);
+    for (uint32_t i = 0; i < length; i++) {
+        uint8_t valueChar = value[i];
+        if (IS_URL_UNRESERVED(valueChar)) {
+            *output++ = (char) valueChar;
+        } else if (isFormEncoding && valueChar == ' ') {
+            *output++ = '+';
+        } else {
+            output[0] = '%';
+            output[1] = HEX_DIGITS[valueChar >> 4];
+            output[2] = HEX_DIGITS[valueChar & 0x0F];
+            output += 3;
+        }
+    }
+    *output = '\0';
+    str->length += encodedLength;
+    str->hash = 0;
+    return str;
+}
+
+BufferString *urlDecode(BufferString *str, const char *value, uint32_t length, bool isFormEncoding) {
+    if (str == NULL || value == NULL) return NULL;
+    uint32_t decodedLength = urlDecodedLength(value, length);
+    if (decodedLength == INVALID_URL_LENGTH || decodedLength >= str->capacity - str->length) return NULL;
+
+    decodeUrlChars(value, length, STRING_END(str), isFormEncoding);
+    str->length += decodedLength;
+    *STRING_END(str) = '\0';
+    str->hash = 0;
+    return str;
+}
+
+BufferString *urlDecodeString(BufferString *str, bool isFormEncoding) {
+    if (str == NULL) return NULL;
+    uint32_t decodedLength = urlDecodedLength(str->value, str->length);
+    if (decodedLength == INVALID_URL_LENGTH) return NULL;
+    if (decodedLength == str->length && (!isFormEncoding || memchr(str->value, '+', str->length) == NULL)) return str;
+
+    decodeUrlChars(str->value, str->length, str->value, isFormEncoding);    // output never overtakes input
+    memset(str->value + decodedLength, 0, str->length - decodedLength);
+    str->length = decodedLength;
+    str->hash = 0;
+    return str;
+}
+
+static uint32_t urlEncodedLength(const char *value, uint32_t length, bool isFormEncoding) {
+    uint32_t encodedLength = length;
+    for (uint32_t i = 0; i < length; i++) {
+        if (!IS_URL_UNRESERVED(value[i]) && !(isFormEncoding && value[i] == ' ')) {
+            encodedLength += 2;
+        }
+    }
+    return encodedLength;
+}
+
+// validates "%" sequences, returns INVALID_URL_LENGTH on invalid one
+static uint32_t urlDecodedLength(const char *value, uint32_t length) {
+    uint32_t decodedLength = length;
+    const char *end = value + length;
+    for (const char *percent = memchr(value, '%', length); percent != NULL; percent = memchr(percent, '%', end - percent)) {
+        if (end - percent < 3 || !IS_URL_HEX_DIGIT(percent[1]) || !IS_URL_HEX_DIGIT(percent[2])) {
+            return INVALID_URL_LENGTH;
+        }
+        decodedLength -= 2;
+        percent += 3;
+    }
+    return decodedLength;
+}
+
+// value should be validated, output can be the same as value
+static uint32_t decodeUrlChars(const char *value, uint32_t length, char *output, bool isFormEncoding) {
+    uint32_t outputLength = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        char valueChar = value[i];
+        if (valueChar == '%') {
+            output[outputLength++] = (char) ((URL_HEX_VALUE(value[i + 1]) << 4) | URL_HEX_VALUE(value[i + 2]));
+            i += 2;
+        } else {
+            output[outputLength++] = (isFormEncoding && valueChar == '+') ? ' ' : valueChar;
+        }
+    }
+    return outputLength;
+}
@@ -0,0 +1,363 @@
+#include "Utf8String.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#define NOT_FOUND_INDEX (-1)
+#define ASCII_WORD_MASK 0x8080808080808080ULL
+#define IS_CONTINUATION_BYTE(byte) (((byte) & 0xC0) == 0x80)
+#define MAX_SEQUENCE_LENGTH 4
+#define BYTE_SUM_MULTIPLIER 0x0101010101010101ULL
+
+static uint32_t validateBlocks(const uint8_t *data, uint32_t length);
+static uint32_t skipAscii(const uint8_t *data, uint32_t length);
+static uint32_t validateSequence(const uint8_t *data, uint32_t length);
+static inline uint64_t continuationBytesInWord(uint64_t word);
+static inline bool hasLongContinuationRun(uint64_t continuationBytes, uint32_t carriedRun);
+static uint32_t scanCodePoints(const uint8_t *data, uint32_t length, uint32_t *offset, uint32_t maxCount);
+static uint32_t skipCodePoints(const uint8_t *data, uint32_t length, uint32_t offset, uint32_t count);
+
+
+bool isValidUtf8(BufferString *str) {
+    return str != NULL && indexOfInvalidUtf8Chars(str->value, str->length) == NOT_FOUND_INDEX;
+}
+
+int32_t indexOfInvalidUtf8(BufferString *str) {
+    return str != NULL ? indexOfInvalidUtf8Chars(str->value, str->length) : NOT_FOUND_INDEX;
+}
+
+int32_t indexOfInvalidUtf8Chars(const char *data, uint32_t length) {
+    if (data == NULL) return NOT_FOUND_INDEX;
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint32_t index = validateBlocks(bytes, length);
+
+    while (index < length) {
+        if (bytes[index] < 0x80) {
+            index += skipAscii(bytes + index, length - index);
+            continue;
+        }
+
+        uint32_t sequenceLength = validateSequence(bytes + index, length - index);
+        if (sequenceLength == 0) return (int32_t) index;
+        index += sequenceLength;
+    }
+    return NOT_FOUND_INDEX;
+}
+
+uint32_t utf8Length(BufferString *str) {
+    return str != NULL ? utf8LengthChars(str->value, str->length) : 0;
+}
+
+uint32_t utf8LengthChars(const char *data, uint32_t length) {
+    if (data == NULL) return 0;
+    uint32_t offset = 0;
+    return scanCodePoints((const uint8_t *) data, length, &offset, UINT32_MAX);
+}
+
+int32_t utf8OffsetOf(BufferString *str, uint32_t index) {
+    if (str == NULL) return NOT_FOUND_INDEX;
+    uint32_t offset = skipCodePoints((const uint8_t *) str->value, str->length, 0, index);
+    return offset <= str->length ? (int32_t) offset : NOT_FOUND_INDEX;
+}
+
+uint32_t utf8CodePointAt(BufferString *str, uint32_t index) {
+    int32_t offset = utf8OffsetOf(str, index);
+    if (offset == NOT_FOUND_INDEX || (uint32_t) offset == str->length) return 0;
+    uint8_t sequenceLength;
+    return decodeUtf8CodePoint(str->value + offset, str->length - offset, &sequenceLength);
+}
+
+Utf8Iterator getUtf8Iterator(BufferString *str) {
+    Utf8Iterator iterator = {
+            .value = (str != NULL) ? str->value : NULL,
+            .length = (str != NULL) ? str->length : 0,
+            .offset = 0,
+    };
+    return iterator;
+}
+
+bool hasNextCodePoint(Utf8Iterator *iterator) {
+    if (iterator == NULL || iterator->value == NULL || iterator->offset >= iterator->length) return false;
+    const uint8_t *data = (const uint8_t *) iterator->value + iterator->offset;
+    uint32_t remaining = iterator->length - iterator->offset;
+    uint8_t sequenceLength;
+    iterator->codePoint = decodeUtf8CodePoint((const char *) data, remaining, &sequenceLength);
+    iterator->codePointOffset = iterator->offset;
+
+    uint32_t nextOffset = 1;    // continuation bytes belong to this code point, also for invalid sequence
+    while (nextOffset < remaining && nextOffset < MAX_SEQUENCE_LENGTH && IS_CONTINUATION_BYTE(data[nextOffset])) {
+        nextOffset++;
+    }
+    iterator->codePointLength = nextOffset;
+    iterator->offset += nextOffset;
+    return true;
+}
+
+BufferString *utf8Substring(BufferString *source, BufferString *destination, uint32_t beginIndex, uint32_t endIndex) {
+    if (source == NULL || destination == NULL || beginIndex > endIndex) return NULL;
+    const uint8_t *data = (const uint8_t *) source->value;
+    uint32_t beginOffset = skipCodePoints(data, source->length, 0, beginIndex);
+    if (beginOffset > source->length) return NULL;
+    uint32_t endOffset = skipCodePoints(data, source->length, beginOffset, endIndex - beginIndex);
+    if (endOffset > source->length) return NULL;
+    return substringFromTo(source, destination, beginOffset, endOffset);
+}
+
+BufferString *reverseUtf8String(BufferString *str) {
+    if (str == NULL || reverseString(str) == NULL) return NULL;
+    uint8_t *data = (uint8_t *) str->value;
+    for (uint32_t i = 0; i < str->length; i++) {    // sequence is reversed to continuation bytes followed by the lead byte
+        if (!IS_CONTINUATION_BYTE(data[i])) continue;
+        uint32_t leadIndex = i;
+        while (leadIndex + 1 < str->length && leadIndex - i + 1 < MAX_SEQUENCE_LENGTH && IS_CONTINUATION_BYTE(data[leadIndex])) {
+            leadIndex++;
+        }
+
+        for (uint32_t start = i, end = leadIndex; start < end; start++, end--) {
+            uint8_t swapByte = data[start];
+            data[start] = data[end];
+            data[end] = swapByte;
+        }
+        i = leadIndex;
+    }
+    return str;
+}
+
+Utf8IndexCache *newUtf8IndexCache(Utf8IndexCache *cache, BufferString *str, uint32_t *offsets, uint32_t capacity) {
+    if (cache == NULL || str == NULL || offsets == NULL || capacity == 0) return NULL;
+    cache->str = str;
+    cache->offsets = offsets;
+    cache->capacity = capacity;
+    cache->length = utf8Length(str);
+    cache->step = (cache->length + capacity - 1) / capacity;
+    cache->step = (cache->step > 0) ? cache->step : 1;
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i * cache->step < cache->length; i++) {
+        offsets[i] = offset;
+        offset = skipCodePoints((const uint8_t *) str->value, str->length, offset, cache->step);
+    }
+    return cache;
+}
+
+int32_t utf8CachedOffsetOf(Utf8IndexCache *cache, uint32_t index) {
+    if (cache == NULL || index > cache->length) return NOT_FOUND_INDEX;
+    if (index == cache->length) return (int32_t) cache->str->length;
+    uint32_t offset = cache->offsets[index / cache->step];
+    return (int32_t) skipCodePoints((const uint8_t *) cache->str->value, cache->str->length, offset, index % cache->step);
+}
+
+uint32_t decodeUtf8CodePoint(const char *chars, uint32_t length, uint8_t *sequenceLength) {
+    const uint8_t *data = (const uint8_t *) chars;
+    if (data == NULL || length == 0) {
+        *sequenceLength = 0;
+        return 0;
+    }
+    *sequenceLength = (data[0] < 0x80) ? 1 : validateSequence(data, length);
+    switch (*sequenceLength) {
+        case 1:
+            return data[0];
+        case 2:
+            return ((data[0] & 0x1F) << 6) | (data[1] & 0x3F);
+        case 3:
+            return ((data[0] & 0x0F) << 12) | ((data[1] & 0x3F) << 6) | (data[2] & 0x3F);
+        case 4:
+            return ((data[0] & 0x07) << 18) | ((data[1] & 0x3F) << 12) | ((data[2] & 0x3F) << 6) | (data[3] & 0x3F);
+        default:
+            *sequenceLength = 1;
+            return UTF8_REPLACEMENT_CHARACTER;
+    }
+}
+
+// Validates 16 byte blocks with three nibble lookup tables (J. Keiser, D. Lemire). Every byte is checked together with
+// 3 previous bytes, so the first invalid sequence starts at most 3 bytes before the block, where error is found.
+// Returns sequence start offset, from which scalar validation should continue: to locate the error or check the tail
+static uint32_t validateBlocks(const uint8_t *data, uint32_t length) {
+    uint32_t index = 0;
+#ifdef __SSSE3__
+    enum {
+        TOO_SHORT = 1 << 0,     // lead byte or ASCII followed by not continuation byte
+        TOO_LONG = 1 << 1,      // ASCII followed by continuation byte
+        OVERLONG_3 = 1 << 2,
+        TOO_LARGE = 1 << 3,
+        SURROGATE = 1 << 4,
+        OVERLONG_2 = 1 << 5,
+        TOO_LARGE_1000 = 1 << 6,
+        OVERLONG_4 = 1 << 6,
+        TWO_CONTINUATIONS = 1 << 7,
+        CARRY = TOO_SHORT | TOO_LONG | TWO_CONTINUATIONS
+    };
+    const __m128i firstHighNibble = _mm_setr_epi8(
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS,
+            TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+    const __m128i firstLowNibble = _mm_setr_epi8(
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY, CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000);
+    const __m128i secondHighNibble = _mm_setr_epi8(
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i highBit = _mm_set1_epi8((char) 0x80);
+    const __m128i thirdByteLimit = _mm_set1_epi8(0xE0 - 0x80);     // high bit is set after saturating subtraction
+    const __m128i fourthByteLimit = _mm_set1_epi8(0xF0 - 0x80);
+    const __m128i incompleteLimits = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                   0xF0 - 1, 0xE0 - 1, 0xC0 - 1);
+    __m128i previous = _mm_setzero_si128();
+    __m128i previousIncomplete = _mm_setzero_si128();
+
+    for (; length - index >= sizeof(__m128i); index += sizeof(__m128i)) {
+        __m128i input = _mm_loadu_si128((const __m128i *) (data + index));
+        if (_mm_movemask_epi8(input) == 0) {    // ASCII block is valid, when previous block has no unfinished sequence
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(previousIncomplete, _mm_setzero_si128())) != 0xFFFF) break;
+        } else {
+            __m128i previous1 = _mm_alignr_epi8(input, previous, sizeof(__m128i) - 1);
+            __m128i lookup = _mm_and_si128(
+                    _mm_and_si128(_mm_shuffle_epi8(firstHighNibble, _mm_and_si128(_mm_srli_epi16(previous1, 4), nibbleMask)),
+                                  _mm_shuffle_epi8(firstLowNibble, _mm_and_si128(previous1, nibbleMask))),
+                    _mm_shuffle_epi8(secondHighNibble, _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask)));
+
+            __m128i previous2 = _mm_alignr_epi8(input, previous, sizeof(__m128i) - 2);
+            __m128i previous3 = _mm_alignr_epi8(input, previous, sizeof(__m128i) - 3);
+            __m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(previous2, thirdByteLimit),
+                                                                    _mm_subs_epu8(previous3, fourthByteLimit)), highBit);
+            __m128i error = _mm_xor_si128(mustBeContinuation, lookup);     // two continuations are expected only there
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) break;
+        }
+        previousIncomplete = _mm_subs_epu8(input, incompleteLimits);
+        previous = input;
+    }
+
+    if (index > 0) {    // bytes before are valid, so the first not continuation byte starts a sequence
+        uint32_t start = (index >= MAX_SEQUENCE_LENGTH - 1) ? index - (MAX_SEQUENCE_LENGTH - 1) : 0;
+        while (start < index && IS_CONTINUATION_BYTE(data[start])) {
+            start++;
+        }
+        index = start;
+    }
+#endif
+    return index;
+}
+
+// most of the text is ASCII, so check whole words for the high bit and validate only multibyte sequences one by one
+static uint32_t skipAscii(const uint8_t *data, uint32_t length) {
+    uint32_t index = 0;
+#ifdef __SSE2__
+    while (length - index >= sizeof(__m128i)) {
+        int highBits = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (data + index)));
+        if (highBits != 0) return index + __builtin_ctz(highBits);
+        index += sizeof(__m128i);
+    }
+#endif
+    while (length - index >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + index, sizeof(uint64_t));
+        if ((word & ASCII_WORD_MASK) != 0) break;
+        index += sizeof(uint64_t);
+    }
+
+    while (index < length && data[index] < 0x80) {
+        index++;
+    }
+    return index;
+}
+
+// returns sequence length or 0 when sequence is invalid
+static uint32_t validateSequence(const uint8_t *data, uint32_t length) {
+    uint8_t leadByte = data[0];
+    uint32_t sequenceLength;
+    uint8_t secondMin = 0x80;   // second byte range excludes overlong forms, surrogates and values above U+10FFFF
+    uint8_t secondMax = 0xBF;
+
+    if (leadByte >= 0xC2 && leadByte <= 0xDF) {
+        sequenceLength = 2;
+    } else if (leadByte >= 0xE0 && leadByte <= 0xEF) {
+        sequenceLength = 3;
+        if (leadByte == 0xE0) secondMin = 0xA0;
+        if (leadByte == 0xED) secondMax = 0x9F;
+    } else if (leadByte >= 0xF0 && leadByte <= 0xF4) {
+        sequenceLength = 4;
+        if (leadByte == 0xF0) secondMin = 0x90;
+        if (leadByte == 0xF4) secondMax = 0x8F;
+    } else {
+        return 0;   // continuation byte without lead byte, overlong 0xC0/0xC1 or 0xF5..0xFF
+    }
+
+    if (length < sequenceLength || data[1] < secondMin || data[1] > secondMax) return 0;
+    for (uint32_t i = 2; i < sequenceLength; i++) {
+        if (!IS_CONTINUATION_BYTE(data[i])) return 0;
+    }
+    return sequenceLength;
+}
+
+// high bit is set in every continuation byte: 10xxxxxx
+static inline uint64_t continuationBytesInWord(uint64_t word) {
+    return word & ~(word << 1) & ASCII_WORD_MASK;
+}
+
+// true when word has a continuation byte, that starts a new code point: 4 in a row, also with the run from previous word
+static inline bool hasLongContinuationRun(uint64_t continuationBytes, uint32_t carriedRun) {
+    uint64_t runOfFour = continuationBytes & (continuationBytes >> 8) & (continuationBytes >> 16) & (continuationBytes >> 24);
+    uint64_t leadingBytes = ASCII_WORD_MASK >> (8 * (sizeof(uint64_t) - (MAX_SEQUENCE_LENGTH - carriedRun)));
+    return runOfFour != 0 || (carriedRun > 0 && (continuationBytes & leadingBytes) == leadingBytes);
+}
+
+// Code point is any byte with up to 3 following continuation bytes, the same rule as in hasNextCodePoint().
+// Offset should be at the code point start, it is moved over at most 'maxCount' code points. Returns count of them
+static uint32_t scanCodePoints(const uint8_t *data, uint32_t length, uint32_t *offset, uint32_t maxCount) {
+    uint32_t index = *offset;
+    uint32_t count = 0;
+    uint32_t continuationRun = MAX_SEQUENCE_LENGTH - 1;     // continuation byte at the start is a code point on its own
+
+    while (true) {
+        uint32_t blockEnd = length;
+        if (length - index >= sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, data + index, sizeof(uint64_t));
+            uint64_t continuationBytes = continuationBytesInWord(word);
+            uint32_t starts = sizeof(uint64_t) - (uint32_t) (((continuationBytes >> 7) * BYTE_SUM_MULTIPLIER) >> 56);
+            if (!hasLongContinuationRun(continuationBytes, continuationRun) && starts <= maxCount - count) {
+                count += starts;
+                index += sizeof(uint64_t);
+                continuationRun = 0;
+                while (continuationRun < MAX_SEQUENCE_LENGTH - 1 && (continuationBytes >> (63 - 8 * continuationRun)) & 1) {
+                    continuationRun++;
+                }
+                continue;
+            }
+            blockEnd = index + sizeof(uint64_t);    // one word byte by byte, then try whole words again
+        }
+        if (index >= length) break;
+
+        for (; index < blockEnd; index++) {
+            if (!IS_CONTINUATION_BYTE(data[index]) || ++continuationRun == MAX_SEQUENCE_LENGTH) {
+                if (count == maxCount) {
+                    *offset = index;
+                    return count;
+                }
+                count++;
+                continuationRun = 0;
+            }
+        }
+    }
+    *offset = index;
+    return count;
+}
+
+// returns offset after 'count' code points from the code point start offset, or length + 1 when string is shorter
+static uint32_t skipCodePoints(const uint8_t *data, uint32_t length, uint32_t offset, uint32_t count) {
+    uint32_t skippedCount = scanCodePoints(data, length, &offset, count);
+    return skippedCount == count ? offset : length + 1;
+}
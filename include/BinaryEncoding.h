@@ -0,0 +1,27 @@
+#pragma once
+
+#include "BufferString.h"
+
+#define BASE64_ENCODED_LENGTH(dataLength) ((((dataLength) + 2) / 3) * 4)
+#define HEX_ENCODED_LENGTH(dataLength) ((dataLength) * 2)
+#define HEXDUMP_MAX_ROW_WIDTH 64
+
+typedef struct HexdumpFormat {
+    uint8_t rowWidth;       // bytes per row, up to HEXDUMP_MAX_ROW_WIDTH
+    uint8_t groupSize;      // extra space after every group of bytes, 0 for no groups
+    bool isUpperCase;
+} HexdumpFormat;
+
+#define HEXDUMP_DEFAULT_FORMAT ((HexdumpFormat) {.rowWidth = 16, .groupSize = 8, .isUpperCase = false})
+
+// Binary to text encodings. Result is appended to the string, its exact length is known before writing.
+// Returns NULL when result does not fit or input is invalid, string is not changed then
+BufferString *hexEncode(BufferString *str, const uint8_t *data, uint32_t length, bool isUpperCase);
+BufferString *hexDecode(BufferString *str, const char *hex, uint32_t length);   // any case, length should be even
+BufferString *base64Encode(BufferString *str, const uint8_t *data, uint32_t length);    // standard alphabet with padding
+BufferString *base64Decode(BufferString *str, const char *base64, uint32_t length);    // padding is optional
+
+// "00000010  48 65 6c 6c 6f 20 57 6f  72 6c 64 0a              |Hello World.|" rows like "hexdump -C".
+// Every row is rendered to the local buffer and written at once, offsets start from baseOffset. Format can be NULL for default
+BufferString *hexdumpToString(BufferString *str, const uint8_t *data, uint32_t length, uint32_t baseOffset, const HexdumpFormat *format);
+StringSink *hexdumpToSink(StringSink *sink, const uint8_t *data, uint32_t length, uint32_t baseOffset, const HexdumpFormat *format);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "DeferredFormat.h"
+
+// Compact binary log records: format id and raw arguments encoded as in DeferredFormat.
+// Device sends only record bytes, host renders them to text with the same format table
+//
+// Record layout: [format id: 2 bytes][arguments length: 2 bytes][arguments], little endian
+#define BINARY_LOG_HEADER_SIZE 4
+#define BINARY_LOG_MAX_ARGUMENTS_LENGTH UINT16_MAX
+
+typedef struct BinaryLogIterator {
+    const char *const *formats;   // indexed by format id
+    uint16_t formatCount;
+    const uint8_t *data;
+    uint32_t length;
+    uint32_t offset;    // start of the first not decoded record
+    uint16_t formatId;  // id of the last decoded record
+} BinaryLogIterator;
+
+// encode, appends record bytes to the string. Returns NULL when record does not fit, string is not changed then
+BufferString *encodeBinaryLog(BufferString *out, uint16_t formatId, const char *format, ...);
+
+// decode, stops at incomplete record, so offset can be used to continue with more received data.
+// Also stops at unknown format id or corrupted arguments
+BinaryLogIterator getBinaryLogIterator(const char *const *formats, uint16_t formatCount, const uint8_t *data, uint32_t length);
+bool hasNextBinaryLog(BinaryLogIterator *iterator, BufferString *line);
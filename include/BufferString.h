@@ -19,6 +19,7 @@ typedef struct BufferString {
     char *value;
     uint32_t length;
     uint32_t capacity;
+    uint32_t hash;  // cached content hash, 0 when not calculated yet. Reset by all modifying functions
 } BufferString;
 
 typedef struct StringIterator {
@@ -28,6 +29,19 @@ typedef struct StringIterator {
     char *nextToken;
 } StringIterator;
 
+typedef struct StringView {     // non owning, length bounded part of other string buffer. Not null terminated
+    const char *value;
+    uint32_t length;
+} StringView;
+
+typedef bool (*StringSinkFlush)(const char *data, uint32_t length, void *context);
+
+typedef struct StringSink {     // staging buffer, that flushed to the callback when full
+    BufferString *buffer;
+    StringSinkFlush flush;
+    void *context;
+} StringSink;
+
 typedef enum StringToI64Status {
     STR_TO_I64_SUCCESS,
     STR_TO_I64_OVERFLOW,
@@ -57,6 +71,8 @@ typedef enum StringToI64Status {
 #define SUBSTRING_CSTR_BEFORE_LAST(capacity, source, separator) substringCStrBeforeLast(source, EMPTY_STRING(capacity), separator)
 #define SUBSTRING_CSTR_BETWEEN(capacity, source, open, close) substringCStrBetween(source, EMPTY_STRING(capacity), open, close)
 
+#define NEW_STRING_SINK(capacity, flush, context) newStringSink(&(StringSink){0}, EMPTY_STRING(capacity), flush, context)
+
 #define INT64_TO_STRING(value) int64ToString(EMPTY_STRING(32), value)
 #define UINT64_TO_STRING(value) uInt64ToString(EMPTY_STRING(32), value)
 
@@ -84,11 +100,19 @@ BufferString *newString(BufferString *str, const void *initValue, char *buffer,
 BufferString *dubString(BufferString *source, BufferString *dest, char *buffer, uint32_t bufferLength);
 BufferString *stringFormat(BufferString *str, const char *format, ...);
 
+// sink
+StringSink *newStringSink(StringSink *sink, BufferString *buffer, StringSinkFlush flush, void *context);
+StringSink *sinkFormat(StringSink *sink, const char *format, ...);
+StringSink *sinkChars(StringSink *sink, const char *chars, uint32_t length);
+StringSink *sinkString(StringSink *sink, BufferString *str);
+StringSink *flushStringSink(StringSink *sink);
+
 // fill
 BufferString *concatCharsByLength(BufferString *str, const char *strToConcat, uint32_t length);
 BufferString *concatChars(BufferString *str, const char *strToConcat);
 BufferString *concatString(BufferString *str, BufferString *strToConcat);
 BufferString *concatChar(BufferString *str, char charToConcat);
+BufferString *concatFormat(BufferString *str, const char *format, ...);
 BufferString *copyString(BufferString *str, const char *strToCopy);
 BufferString *copyStringByLength(BufferString *str, const char *strToCopy, uint32_t length);
 BufferString *clearString(BufferString *str);
@@ -100,6 +124,8 @@ BufferString *swapCase(BufferString *str);
 BufferString *replaceFirstOccurrence(BufferString *source, const char *target, const char *replacement);
 BufferString *replaceAllOccurrences(BufferString *source, const char *target, const char *replacement);
 BufferString *trimAll(BufferString *str);
+StringView trimToView(BufferString *str);
+StringView trimStringView(StringView view);
 BufferString *reverseString(BufferString *str);
 BufferString *capitalize(BufferString *str, const char *delimiters, uint32_t length);
 
@@ -140,6 +166,10 @@ BufferString *uInt64ToString(BufferString *str, uint64_t value);
 StringToI64Status stringToI64(BufferString *str, int64_t *out, int base);
 StringToI64Status cStrToInt64(const char *str, int64_t *out, int base);
 
+// hash
+uint32_t stringHash(const void *data, uint32_t length);
+uint32_t stringHashCode(BufferString *str);
+
 // check
 bool isBuffStrBlank(BufferString *str);
 bool isCstrBlank(const char *str);
@@ -197,6 +227,10 @@ static inline bool isBuffStringNotEquals(BufferString *one, BufferString *two) {
     return !isBuffStrEquals(one, two);
 }
 
+static inline StringView toStringView(BufferString *str) {
+    return (str != NULL) ? (StringView) {.value = str->value, .length = str->length} : (StringView) {0};
+}
+
 // properties
 static inline char *stringValue(BufferString *str) { return str != NULL ? str->value : NULL; }
 static inline uint32_t stringLength(BufferString *str) { return str != NULL ? str->length : 0; }
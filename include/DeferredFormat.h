@@ -0,0 +1,42 @@
+#pragma once
+
+#include "BufferString.h"
+
+// Captures format arguments in a compact binary form and renders them to string only when needed.
+// Numbers are stored little endian with fixed size, "%s" and "%S" values are copied by length with null terminator
+typedef struct DeferredFormat {
+    const char *format;     // not copied, should stay valid until rendered
+    uint8_t *arguments;
+    uint32_t length;
+    uint32_t capacity;
+} DeferredFormat;
+
+#ifndef DEFERRED_FORMAT_MAX_ARGUMENTS
+#define DEFERRED_FORMAT_MAX_ARGUMENTS 16  // including '*' width and precision arguments
+#endif
+
+// Argument types of the format, parsed once. C variadic arguments can be read only by their type, so capture needs
+// them, but with signature the format string is not scanned on every capture
+typedef struct DeferredFormatSignature {
+    const char *format;     // not copied, should stay valid until rendered
+    uint8_t argumentTypes[DEFERRED_FORMAT_MAX_ARGUMENTS];
+    uint8_t argumentCount;
+} DeferredFormatSignature;
+
+// initialization
+#define NEW_DEFERRED_FORMAT(capacity) newDeferredFormat(&(DeferredFormat){0}, (uint8_t[capacity]){0}, capacity)
+#define NEW_DEFERRED_FORMAT_BUFF(buffer) newDeferredFormat(&(DeferredFormat){0}, buffer, sizeof(buffer))
+
+DeferredFormat *newDeferredFormat(DeferredFormat *record, uint8_t *buffer, uint32_t capacity);
+
+// capture, returns NULL when arguments don't fit to the record buffer or format has more than DEFERRED_FORMAT_MAX_ARGUMENTS
+DeferredFormat *deferFormat(DeferredFormat *record, const char *format, ...);
+DeferredFormat *deferFormatList(DeferredFormat *record, const char *format, va_list vaList);
+
+// capture for hot paths: format is parsed once to signature, then every capture only reads and stores the arguments
+DeferredFormatSignature *newDeferredFormatSignature(DeferredFormatSignature *signature, const char *format);
+DeferredFormat *deferSignatureFormat(DeferredFormat *record, DeferredFormatSignature *signature, ...);
+DeferredFormat *deferSignatureFormatList(DeferredFormat *record, DeferredFormatSignature *signature, va_list vaList);
+
+// render, same result as stringFormat() with original arguments. Returns NULL on overflow or corrupted arguments
+BufferString *renderDeferredFormat(BufferString *str, DeferredFormat *record);
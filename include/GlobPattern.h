@@ -0,0 +1,54 @@
+#pragma once
+
+#include "BufferString.h"
+
+#ifndef GLOB_MAX_TOKENS
+#define GLOB_MAX_TOKENS 64  // token limit for patterns, that are matched without own compiled form
+#endif
+#ifndef GLOB_MAX_CHAR_GROUPS
+#define GLOB_MAX_CHAR_GROUPS 16     // distinct char masks, each takes 8 bytes of GlobPattern
+#endif
+#define GLOB_MAX_MASKED_TOKENS 64
+// isStrMatchesGlob() stack use: GlobPattern (~400 bytes with 16 groups) + GLOB_MAX_TOKENS * sizeof(GlobToken) (6 bytes each)
+
+// Glob patterns: "*" any string, "?" any char, "[a-z0-9_]" and "[!0-9]" classes, "\" escapes next char.
+// Pattern is split by stars to segments, each segment is searched once from left to right without backtracking,
+// so match takes linear time. Segments of plain chars keep KMP failure links, other segments between stars are
+// searched with Shift-And bit masks. Classes and tokens of such segments take one mask bit each, up to GLOB_MAX_MASKED_TOKENS.
+// Chars with the same mask share a group, so only up to GLOB_MAX_CHAR_GROUPS masks are stored
+typedef enum GlobTokenType {
+    GLOB_CHAR,
+    GLOB_ANY_CHAR,
+    GLOB_CLASS,
+    GLOB_ANY_STRING
+} GlobTokenType;
+
+typedef struct GlobToken {
+    uint8_t type;
+    char symbol;
+    bool isLiteralSegment;  // segment between stars has only plain chars
+    uint8_t bit;            // bit in char masks for classes and tokens of masked segments
+    uint16_t failure;       // KMP failure link in the literal segment
+} GlobToken;
+
+typedef struct GlobPattern {
+    GlobToken *tokens;
+    uint16_t tokenCount;
+    uint16_t tokenCapacity;
+    uint8_t maskedTokenCount;
+    uint8_t charGroupCount;
+    uint8_t charGroups[256];    // group of every char, group 0 is for chars not mentioned in masked tokens
+    uint64_t groupMasks[GLOB_MAX_CHAR_GROUPS];  // bits of the tokens, that accept chars of the group
+} GlobPattern;
+
+// initialization, token capacity should be at least pattern length
+#define NEW_GLOB_PATTERN(tokenCapacity, pattern) compileGlobPattern(&(GlobPattern){0}, (GlobToken[tokenCapacity]){0}, tokenCapacity, pattern)
+#define NEW_GLOB_PATTERN_BUFF(tokens, pattern) compileGlobPattern(&(GlobPattern){0}, tokens, sizeof(tokens) / sizeof((tokens)[0]), pattern)
+
+// returns NULL for not closed class, trailing escape, not enough tokens, more than GLOB_MAX_MASKED_TOKENS masked tokens
+// or more than GLOB_MAX_CHAR_GROUPS distinct char masks. Pattern string is not used after compilation
+GlobPattern *compileGlobPattern(GlobPattern *glob, GlobToken *tokens, uint16_t tokenCapacity, const char *pattern);
+
+bool isGlobMatch(GlobPattern *glob, StringView text);
+bool isGlobMatchString(GlobPattern *glob, BufferString *str);
+bool isStrMatchesGlob(BufferString *str, const char *pattern);  // compiles pattern to GLOB_MAX_TOKENS local tokens, false when it doesn't fit
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "BufferString.h"
+
+typedef enum HttpParseStatus {
+    HTTP_PARSE_COMPLETE,    // request line and all headers are parsed, body starts at bodyOffset
+    HTTP_PARSE_PARTIAL,     // more data is needed, call again after it is appended to the string
+    HTTP_PARSE_INVALID,
+    HTTP_PARSE_TOO_MANY_HEADERS,
+    HTTP_PARSE_UNSUPPORTED_VERSION  // well formed version other than HTTP/1.0 and HTTP/1.1
+} HttpParseStatus;
+
+typedef struct HttpHeader {
+    StringView name;
+    StringView value;   // without surrounding whitespaces
+} HttpHeader;
+
+// Zero copy, incremental HTTP/1.0 and HTTP/1.1 request parser. All views point to the parsed string, so its value
+// should not be moved or changed before request is handled, data should be only appended between calls.
+// String should contain only the request, "+IPD" frame headers of ESP AT firmware are removed by parseIpdFrame()
+typedef struct HttpRequest {
+    StringView method;
+    StringView path;
+    StringView query;       // after '?', empty when there is no query
+    StringView version;     // "HTTP/1.0" or "HTTP/1.1"
+    HttpHeader *headers;
+    uint32_t headerCount;
+    uint32_t headerCapacity;
+    uint32_t offset;        // start of the first not parsed line
+    uint32_t bodyOffset;
+    bool isRequestLineParsed;
+    bool isComplete;
+} HttpRequest;
+
+// initialization
+#define NEW_HTTP_REQUEST(headerCapacity) newHttpRequest(&(HttpRequest){0}, (HttpHeader[headerCapacity]){0}, headerCapacity)
+#define NEW_HTTP_REQUEST_BUFF(headers) newHttpRequest(&(HttpRequest){0}, headers, sizeof(headers) / sizeof((headers)[0]))
+
+HttpRequest *newHttpRequest(HttpRequest *request, HttpHeader *headers, uint32_t headerCapacity);   // also resets for the next request
+
+// Parses complete lines, that were not parsed before. Lines can end with "\r\n" or "\n"
+HttpParseStatus parseHttpRequest(HttpRequest *request, BufferString *str);
+StringView getHttpHeader(HttpRequest *request, const char *name);     // case-insensitive, empty view when not found
+
+// ESP AT "+IPD,<id>,<length>:<payload>" or single connection "+IPD,<length>:<payload>" frame, leading line ends are skipped.
+// On HTTP_PARSE_COMPLETE payload points inside data, the frame ends at payload end. Link id is UINT32_MAX without id
+HttpParseStatus parseIpdFrame(StringView data, StringView *payload, uint32_t *linkId);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "BufferString.h"
+
+// JSON string escaping. Quotes, backslash and control chars are always escaped, non ASCII chars optionally as "\uXXXX".
+// Returns NULL when result does not fit, string is not changed then
+BufferString *concatJsonEscaped(BufferString *str, const char *value, uint32_t length, bool isEscapeNonAscii);
+
+// in place, returns NULL on invalid escape sequence and string is not changed then
+BufferString *unescapeJsonString(BufferString *str);
+
+typedef enum JsonTokenType {
+    JSON_OBJECT,
+    JSON_ARRAY,
+    JSON_STRING,    // offset and length are without quotes, value is not unescaped
+    JSON_NUMBER,
+    JSON_BOOL,
+    JSON_NULL
+} JsonTokenType;
+
+typedef enum JsonTokenizeError {
+    JSON_ERROR_NO_TOKENS = -1,  // not enough tokens provided
+    JSON_ERROR_INVALID = -2,
+    JSON_ERROR_PARTIAL = -3     // valid beginning, more data expected
+} JsonTokenizeError;
+
+typedef struct JsonToken {
+    JsonTokenType type;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t size;      // keys of object, elements of array, 1 for key that has value
+    int32_t parent;     // object key is parent of the value, -1 for root
+} JsonToken;
+
+// Zero copy tokenizer: tokens refer to the json string, which should not be changed while tokens are used.
+// Returns number of tokens or negative JsonTokenizeError, tokens are in document order with the root first
+int32_t tokenizeJson(BufferString *json, JsonToken *tokens, uint32_t capacity);
+
+StringView jsonTokenView(BufferString *json, JsonToken *token);
+bool isJsonTokenEquals(BufferString *json, JsonToken *token, const char *value);    // compares not unescaped value
+int32_t findJsonKey(BufferString *json, JsonToken *tokens, uint32_t count, uint32_t objectIndex, const char *key);  // returns index of value or -1
+StringToI64Status jsonTokenToI64(BufferString *json, JsonToken *token, int64_t *out);   // integers only, without fraction and exponent
+bool jsonTokenToDouble(BufferString *json, JsonToken *token, double *out);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "JsonString.h"
+
+#ifndef JSON_WRITER_MAX_DEPTH
+#define JSON_WRITER_MAX_DEPTH 16
+#endif
+
+// Writes JSON directly to the string or to the sink. Commas and nesting are tracked by the writer.
+// All functions return NULL on overflow or invalid structure (value without key in object, not matching end, etc.),
+// so calls can be chained as with BufferString functions
+typedef struct JsonWriter {
+    BufferString *str;
+    StringSink *sink;
+    uint8_t depth;
+    bool isKeyWritten;
+    bool isRootWritten;
+    uint8_t levels[JSON_WRITER_MAX_DEPTH];
+} JsonWriter;
+
+// initialization
+#define NEW_JSON_WRITER(str) newJsonWriter(&(JsonWriter){0}, str)
+#define NEW_JSON_SINK_WRITER(sink) newJsonSinkWriter(&(JsonWriter){0}, sink)
+
+JsonWriter *newJsonWriter(JsonWriter *writer, BufferString *str);     // appends to existing value
+JsonWriter *newJsonSinkWriter(JsonWriter *writer, StringSink *sink);
+
+// structure
+JsonWriter *jsonBeginObject(JsonWriter *writer);
+JsonWriter *jsonEndObject(JsonWriter *writer);
+JsonWriter *jsonBeginArray(JsonWriter *writer);
+JsonWriter *jsonEndArray(JsonWriter *writer);
+JsonWriter *jsonKey(JsonWriter *writer, const char *key);
+JsonWriter *jsonKeyView(JsonWriter *writer, StringView key);
+
+// values
+JsonWriter *jsonString(JsonWriter *writer, const char *value);
+JsonWriter *jsonStringView(JsonWriter *writer, StringView value);
+JsonWriter *jsonBufferString(JsonWriter *writer, BufferString *value);
+JsonWriter *jsonInt(JsonWriter *writer, int64_t value);
+JsonWriter *jsonUInt(JsonWriter *writer, uint64_t value);
+JsonWriter *jsonBool(JsonWriter *writer, bool value);
+JsonWriter *jsonNull(JsonWriter *writer);
+JsonWriter *jsonRaw(JsonWriter *writer, const char *json, uint32_t length);    // already valid JSON value, written as is
+#ifdef ENABLE_FLOAT_FORMATTING
+JsonWriter *jsonDouble(JsonWriter *writer, double value, int32_t precision);  // NaN and infinity are written as null
+#endif
+
+bool isJsonWriterComplete(JsonWriter *writer);    // root value is written and all objects and arrays are closed
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "BufferString.h"
+
+#ifdef ENABLE_POSIX_IO
+#include <stddef.h>
+
+// Read only BufferString, backed by memory mapped file. Content is always null terminated, so all non modifying functions
+// can be used (search, split, compare, substring to other string). Modifying functions must not be called
+typedef struct MappedString {
+    BufferString str;
+    size_t mappedLength;
+} MappedString;
+
+// NULL for not regular files and files that report zero size while having content, like procfs
+BufferString *mapFileToString(MappedString *mapped, const char *path);
+void unmapFileString(MappedString *mapped);
+#endif
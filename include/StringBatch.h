@@ -0,0 +1,43 @@
+#pragma once
+
+#include "BufferString.h"
+
+#ifdef ENABLE_MULTITHREADING
+#include <pthread.h>
+
+// Applies the same operation to array of strings with the small pool of worker threads.
+// Threads take chunks of elements from the shared counter, so faster threads just take more chunks
+typedef BufferString *(*StringBatchOperation)(BufferString *str, uint32_t index, void *context);   // NULL is failure
+typedef void (*StringBatchTask)(uint32_t index, void *context);
+
+typedef struct StringBatchJob StringBatchJob;
+
+typedef struct StringBatchPool {
+    pthread_t *threads;
+    uint32_t threadCount;
+    pthread_mutex_t lock;
+    pthread_cond_t jobReady;
+    pthread_cond_t jobDone;
+    StringBatchJob *job;
+    uint32_t jobGeneration;
+    uint32_t activeWorkers;
+    bool isStopping;
+} StringBatchPool;
+
+// initialization, starts threads. Calling thread also works on the batch, so pool with N threads uses N + 1 cores
+#define NEW_STRING_BATCH_POOL(threadCount) newStringBatchPool(&(StringBatchPool){0}, (pthread_t[threadCount]){0}, threadCount)
+
+StringBatchPool *newStringBatchPool(StringBatchPool *pool, pthread_t *threads, uint32_t threadCount);
+StringBatchPool *stopStringBatchPool(StringBatchPool *pool);
+
+// runs one batch at a time and waits until all elements are done. Results are optional, returns count of failed elements
+uint32_t runStringBatch(StringBatchPool *pool, BufferString **strings, uint32_t count,
+                        StringBatchOperation operation, void *context, BufferString **results);
+// runs task once for each index from 0 to count, for work that is not bound to string array
+void runStringBatchTasks(StringBatchPool *pool, uint32_t count, StringBatchTask task, void *context);
+
+// parallel search. String is split to chunks overlapped by needle length - 1, so match on the chunk border is not lost
+int32_t parallelIndexOfString(StringBatchPool *pool, BufferString *str, const char *stringToFind);
+// all match offsets in ascending order, overlapping matches included. Stores up to capacity offsets, returns total count
+uint32_t parallelFindAllStrings(StringBatchPool *pool, BufferString *str, const char *stringToFind, uint32_t *offsets, uint32_t capacity);
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "StringMap.h"
+
+// Stores every unique string only once in contiguous arena. Interned strings are immutable, null terminated and never move,
+// so two interned strings are equal only when they have the same pointer
+typedef struct StringInternTable {
+    char *arena;
+    uint32_t arenaLength;
+    uint32_t arenaCapacity;
+    StringMap index;
+} StringInternTable;
+
+// initialization, entry capacity should be a power of two
+#define NEW_STRING_INTERN_TABLE(arenaCapacity, entryCapacity) \
+    newStringInternTable(&(StringInternTable){0}, (char[arenaCapacity]){0}, arenaCapacity, (StringMapEntry[entryCapacity]){0}, entryCapacity)
+
+StringInternTable *newStringInternTable(StringInternTable *table, char *arena, uint32_t arenaCapacity, StringMapEntry *entries, uint32_t entryCapacity);
+StringInternTable *clearStringInternTable(StringInternTable *table);
+
+// intern, returns existing or newly stored string. Empty view returned when there is no space left
+StringView internView(StringInternTable *table, StringView str);
+StringView internString(StringInternTable *table, BufferString *str);
+StringView internCStr(StringInternTable *table, const char *str);
+
+// find already interned string, empty view returned when not found
+StringView findInterned(StringInternTable *table, StringView str);
+
+static inline bool isInternedEquals(StringView one, StringView two) {
+    return one.value == two.value;
+}
+
+// properties
+static inline uint32_t internedCount(StringInternTable *table) { return table != NULL ? stringMapSize(&table->index) : 0; }
+static inline uint32_t internArenaLength(StringInternTable *table) { return table != NULL ? table->arenaLength : 0; }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "BufferString.h"
+
+#ifdef ENABLE_POSIX_IO
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+// Collects strings and views without copy and writes them with a single writev()/sendmsg() call.
+// Partial writes are tracked, so next write resumes from the first not written byte
+typedef struct StringIoVector {
+    struct iovec *vectors;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t index;     // first not fully written vector
+    size_t remainingLength;
+} StringIoVector;
+
+// initialization
+#define NEW_STRING_IO_VECTOR(capacity) newStringIoVector(&(StringIoVector){0}, (struct iovec[capacity]){0}, capacity)
+
+StringIoVector *newStringIoVector(StringIoVector *ioVector, struct iovec *vectors, uint32_t capacity);
+StringIoVector *clearStringIoVector(StringIoVector *ioVector);
+
+// add, data is not copied and should stay unchanged until written. Returns NULL when there is no free vectors left
+StringIoVector *addIoVectorChars(StringIoVector *ioVector, const char *data, uint32_t length);
+StringIoVector *addIoVectorString(StringIoVector *ioVector, BufferString *str);
+StringIoVector *addIoVectorView(StringIoVector *ioVector, StringView view);
+StringIoVector *addIoVectorCStr(StringIoVector *ioVector, const char *str);
+
+// write, single system call. Returns written byte count or -1 with errno set
+ssize_t writeStringIoVector(StringIoVector *ioVector, int fd);
+ssize_t sendStringIoVector(StringIoVector *ioVector, int socket, int flags);
+
+// write until all data is written or error occurs, interrupted calls are restarted
+StringIoVector *writeAllStringIoVector(StringIoVector *ioVector, int fd);
+
+static inline bool isStringIoVectorDone(StringIoVector *ioVector) {
+    return ioVector == NULL || ioVector->remainingLength == 0;
+}
+
+static inline size_t stringIoVectorRemaining(StringIoVector *ioVector) {
+    return ioVector != NULL ? ioVector->remainingLength : 0;
+}
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "StringRingBuffer.h"
+
+#ifdef ENABLE_MULTITHREADING
+#include <pthread.h>
+#endif
+
+// Lock free multiple producer, single consumer log buffer.
+// Each producer formats the record into its own (stack or thread local) string, claims space in the shared ring
+// with atomic compare and swap and copies the record there. Consumer reads records in the claim order
+typedef struct StringLogBuffer {
+    char *buffer;
+    uint32_t capacity;
+    uint32_t reserved;      // claimed by producers, free running position
+    uint32_t tail;          // released by consumer, free running position
+    uint32_t droppedCount;
+} StringLogBuffer;
+
+// initialization, capacity should be a power of two. Buffer is allocated as uint32_t array for the header alignment
+#define NEW_STRING_LOG_BUFFER(capacity) newStringLogBuffer(&(StringLogBuffer){0}, (uint32_t[(capacity) / sizeof(uint32_t)]){0}, capacity)
+#define NEW_STRING_LOG_BUFFER_BUFF(buffer) newStringLogBuffer(&(StringLogBuffer){0}, buffer, sizeof(buffer))
+
+StringLogBuffer *newStringLogBuffer(StringLogBuffer *log, void *buffer, uint32_t capacity);
+
+// producers, safe to call from any thread. Returns NULL and counts record as dropped when there is no space
+StringLogBuffer *appendLogChars(StringLogBuffer *log, const char *record, uint32_t length);
+StringLogBuffer *appendLogString(StringLogBuffer *log, BufferString *record);
+
+// consumer, only one thread at the time. Stops at the first record that is claimed but still copied by producer
+uint32_t drainStringLog(StringLogBuffer *log, StringRingConsumer consumer, void *context, uint32_t maxCount);
+
+bool isStringLogEmpty(StringLogBuffer *log);
+uint32_t stringLogDroppedCount(StringLogBuffer *log);
+
+#ifdef ENABLE_MULTITHREADING
+// Background thread that drains the log buffer and sleeps for the interval when it is empty
+typedef struct StringLogFlusher {
+    StringLogBuffer *log;
+    StringRingConsumer consumer;
+    void *context;
+    uint32_t intervalMs;
+    bool isRunning;
+    pthread_t thread;
+} StringLogFlusher;
+
+StringLogFlusher *startStringLogFlusher(StringLogFlusher *flusher, StringLogBuffer *log,
+                                        StringRingConsumer consumer, void *context, uint32_t intervalMs);
+// stops the thread after all already committed records are flushed
+StringLogFlusher *stopStringLogFlusher(StringLogFlusher *flusher);
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "BufferString.h"
+
+// Fixed capacity open addressing (Robin Hood) hash map with string keys. Entries array provided by the caller, no allocations.
+// Keys are not copied, so key buffer must outlive the map entry
+typedef struct StringMapEntry {
+    StringView key;
+    void *value;
+    uint32_t hash;  // 0 - empty slot
+} StringMapEntry;
+
+typedef struct StringMap {
+    StringMapEntry *entries;
+    uint32_t capacity;  // power of two
+    uint32_t size;
+} StringMap;
+
+typedef struct StringMapIterator {
+    StringMap *map;
+    uint32_t index;
+    StringView key;
+    void *value;
+} StringMapIterator;
+
+// initialization, capacity should be a power of two
+#define NEW_STRING_MAP(capacity) newStringMap(&(StringMap){0}, (StringMapEntry[capacity]){0}, capacity)
+#define NEW_STRING_MAP_BUFF(entries) newStringMap(&(StringMap){0}, entries, sizeof(entries) / sizeof((entries)[0]))   // create map from existing local or static entry array
+
+StringMap *newStringMap(StringMap *map, StringMapEntry *entries, uint32_t capacity);
+StringMap *clearStringMap(StringMap *map);
+
+// put, returns NULL when map is full
+StringMap *stringMapPut(StringMap *map, StringView key, void *value);
+StringMap *stringMapPutString(StringMap *map, BufferString *key, void *value);
+StringMap *stringMapPutCStr(StringMap *map, const char *key, void *value);
+
+// get, returns NULL when key not found
+void *stringMapGet(StringMap *map, StringView key);
+void *stringMapGetString(StringMap *map, BufferString *key);
+void *stringMapGetCStr(StringMap *map, const char *key);
+
+// check
+bool isStringMapContains(StringMap *map, StringView key);
+
+// remove, returns removed value or NULL when key not found
+void *stringMapRemove(StringMap *map, StringView key);
+
+// iterate
+StringMapIterator getStringMapIterator(StringMap *map);
+bool hasNextMapEntry(StringMapIterator *iterator);
+
+// properties
+static inline uint32_t stringMapSize(StringMap *map) { return map != NULL ? map->size : 0; }
+static inline uint32_t stringMapCapacity(StringMap *map) { return map != NULL ? map->capacity : 0; }
+static inline bool isStringMapEmpty(StringMap *map) { return stringMapSize(map) == 0; }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BufferString.h"
+
+// Aho-Corasick multi pattern matcher. Finds all patterns in a single pass over the input, also across chunk boundaries.
+// Trie nodes are stored in the array provided by the caller, each pattern char takes at most one node
+typedef struct StringMatcherNode {
+    uint16_t firstChild;
+    uint16_t nextSibling;
+    uint16_t fail;
+    uint16_t dictionaryLink;    // closest pattern end node reachable by fail links
+    uint16_t patternId;
+    uint16_t depth;
+    char symbol;
+} StringMatcherNode;
+
+typedef struct StringMatcher {
+    StringMatcherNode *nodes;
+    uint16_t nodeCapacity;
+    uint16_t nodeCount;
+    uint16_t patternCount;
+    bool isCompiled;
+    uint16_t state;         // streaming state, saved between chunks
+    uint32_t streamOffset;
+} StringMatcher;
+
+typedef struct StringMatch {
+    uint16_t patternId;     // pattern index in order of addition
+    uint32_t offset;        // match start from the beginning of the stream or string
+    uint32_t length;
+} StringMatch;
+
+typedef struct StringMatchIterator {
+    StringMatcher *matcher;
+    const char *text;
+    uint32_t length;
+    uint32_t position;
+    uint16_t outputNode;
+    StringMatch match;
+} StringMatchIterator;
+
+// initialization, node capacity should be at least total length of all patterns + 1
+#define NEW_STRING_MATCHER(nodeCapacity) newStringMatcher(&(StringMatcher){0}, (StringMatcherNode[nodeCapacity]){0}, nodeCapacity)
+#define NEW_STRING_MATCHER_BUFF(nodes) newStringMatcher(&(StringMatcher){0}, nodes, sizeof(nodes) / sizeof((nodes)[0]))
+
+StringMatcher *newStringMatcher(StringMatcher *matcher, StringMatcherNode *nodes, uint16_t nodeCapacity);
+
+// patterns should be added before compilation. Returns NULL when pattern is empty, duplicated or not enough nodes left
+StringMatcher *addMatcherPattern(StringMatcher *matcher, const char *pattern);
+StringMatcher *addMatcherPatternByLength(StringMatcher *matcher, const char *pattern, uint32_t length);
+StringMatcher *compileStringMatcher(StringMatcher *matcher);
+
+// search the whole string, stream state is not used. Reports the leftmost match, the longest one when several start there
+bool findFirstMatch(StringMatcher *matcher, BufferString *str, StringMatch *match);
+
+// streaming search, state is continued from the previous chunk. Iterate till the end of chunk before passing the next one
+StringMatchIterator getStringMatchIterator(StringMatcher *matcher, const char *chunk, uint32_t length);
+bool hasNextMatch(StringMatchIterator *iterator);
+StringMatcher *resetStringMatcher(StringMatcher *matcher);
+
+static inline StringMatchIterator getBufferStringMatchIterator(StringMatcher *matcher, BufferString *str) {
+    return getStringMatchIterator(matcher, stringValue(str), stringLength(str));
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "BufferString.h"
+
+// returns count of bytes read, 0 at the end of stream or negative value on error
+typedef int32_t (*StringReadCallback)(char *buffer, uint32_t length, void *context);
+
+typedef enum StringReaderStatus {
+    STRING_READER_OK,
+    STRING_READER_END_OF_STREAM,
+    STRING_READER_READ_ERROR,   // buffered data is kept, so reading can be retried
+    STRING_READER_OVERFLOW      // record is longer than the buffer, it is dropped up to the next delimiter
+} StringReaderStatus;
+
+// Buffered reader, that splits input to delimiter terminated records without copy. Partial records are kept between reads
+typedef struct StringReader {
+    char *buffer;
+    uint32_t capacity;
+    uint32_t start;     // first not consumed byte
+    uint32_t end;       // end of read data
+    uint32_t scanned;   // count of bytes after start, that already checked for delimiter
+    char delimiter;
+    bool isEndOfStream;
+    bool isSkippingRecord;  // rest of the overflowed record is dropped till the next delimiter
+    StringReaderStatus status;
+    StringReadCallback read;
+    void *context;
+} StringReader;
+
+// initialization
+#define NEW_STRING_READER(capacity, read, context, delimiter) newStringReader(&(StringReader){0}, (char[capacity]){0}, capacity, read, context, delimiter)
+
+StringReader *newStringReader(StringReader *reader, char *buffer, uint32_t capacity, StringReadCallback read, void *context, char delimiter);
+
+// record view points to the reader buffer and valid only until next call. Delimiter is not included
+bool hasNextRecord(StringReader *reader, StringView *record);
+
+#ifdef ENABLE_POSIX_IO
+#define NEW_FD_STRING_READER(capacity, fd, delimiter) newFdStringReader(&(StringReader){0}, (char[capacity]){0}, capacity, fd, delimiter)
+
+StringReader *newFdStringReader(StringReader *reader, char *buffer, uint32_t capacity, int fd, char delimiter);
+#endif
+
+static inline StringReaderStatus stringReaderStatus(StringReader *reader) {
+    return reader != NULL ? reader->status : STRING_READER_READ_ERROR;
+}
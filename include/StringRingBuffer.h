@@ -0,0 +1,31 @@
+#pragma once
+
+#include "BufferString.h"
+
+// Lock free single producer, single consumer ring of variable length string records.
+// Producer formats directly into the reserved ring slot, so record is copied only once
+typedef struct StringRingBuffer {
+    char *buffer;
+    uint32_t capacity;
+    uint32_t head;          // written by producer only
+    uint32_t tail;          // written by consumer only
+    uint32_t reservedStart; // producer side reservation
+} StringRingBuffer;
+
+// returns false to stop draining, record is not released in that case
+typedef bool (*StringRingConsumer)(StringView record, void *context);
+
+// initialization, capacity should be a multiple of 4
+#define NEW_STRING_RING_BUFFER(capacity) newStringRingBuffer(&(StringRingBuffer){0}, (char[capacity]){0}, capacity)
+#define NEW_STRING_RING_BUFFER_BUFF(buffer) newStringRingBuffer(&(StringRingBuffer){0}, buffer, sizeof(buffer))
+
+StringRingBuffer *newStringRingBuffer(StringRingBuffer *ring, char *buffer, uint32_t capacity);
+
+// producer, slot string can hold maxLength chars. Record is visible to consumer only after commit
+BufferString *reserveRingString(StringRingBuffer *ring, BufferString *slot, uint32_t maxLength);
+StringRingBuffer *commitRingString(StringRingBuffer *ring, BufferString *slot);
+
+// consumer, drains up to maxCount records and releases them at once. Returns count of consumed records
+uint32_t drainStringRing(StringRingBuffer *ring, StringRingConsumer consumer, void *context, uint32_t maxCount);
+
+bool isStringRingEmpty(StringRingBuffer *ring);
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "BufferString.h"
+
+// URL percent-encoding. Unreserved chars (RFC 3986: letters, digits, "-._~") are kept, other bytes are encoded as "%XX".
+// With form encoding (application/x-www-form-urlencoded) space is "+".
+// All functions return NULL when result does not fit or on invalid "%" sequence, string is not changed then
+BufferString *urlEncode(BufferString *str, const char *value, uint32_t length, bool isFormEncoding);    // appends
+BufferString *urlDecode(BufferString *str, const char *value, uint32_t length, bool isFormEncoding);    // appends
+BufferString *urlDecodeString(BufferString *str, bool isFormEncoding);  // in place
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "BufferString.h"
+
+#define UTF8_REPLACEMENT_CHARACTER 0xFFFD
+
+// Iterates code points. Invalid sequence is returned as U+FFFD, so iteration never stops in the middle of the string
+typedef struct Utf8Iterator {
+    const char *value;
+    uint32_t length;
+    uint32_t offset;        // byte offset of the next code point
+    uint32_t codePoint;
+    uint32_t codePointOffset;
+    uint8_t codePointLength;
+} Utf8Iterator;
+
+// Byte offsets of every 'step' code point, for fast random access by code point index.
+// Should be created again after the string is changed
+typedef struct Utf8IndexCache {
+    BufferString *str;
+    uint32_t *offsets;
+    uint32_t capacity;
+    uint32_t step;
+    uint32_t length;        // in code points
+} Utf8IndexCache;
+
+#define UTF8_SUBSTRING(capacity, source, beginIndex, endIndex) utf8Substring(source, EMPTY_STRING(capacity), beginIndex, endIndex)
+#define NEW_UTF8_INDEX_CACHE(capacity, str) newUtf8IndexCache(&(Utf8IndexCache){0}, str, (uint32_t[capacity]){0}, capacity)
+
+// UTF-8 validation (RFC 3629): overlong forms, surrogates and code points above U+10FFFF are invalid
+bool isValidUtf8(BufferString *str);
+int32_t indexOfInvalidUtf8(BufferString *str);     // start of the first invalid sequence or -1 when all is valid
+int32_t indexOfInvalidUtf8Chars(const char *data, uint32_t length);
+
+// code points, all indexes are in code points. Code point is a byte with up to 3 following continuation bytes,
+// so also invalid input is split the same way as by hasNextCodePoint()
+uint32_t utf8Length(BufferString *str);
+uint32_t utf8LengthChars(const char *data, uint32_t length);
+int32_t utf8OffsetOf(BufferString *str, uint32_t index);     // byte offset or -1 when out of range
+uint32_t utf8CodePointAt(BufferString *str, uint32_t index);  // 0 when out of range
+uint32_t decodeUtf8CodePoint(const char *data, uint32_t length, uint8_t *sequenceLength);    // U+FFFD with length 1 when invalid
+
+Utf8Iterator getUtf8Iterator(BufferString *str);
+bool hasNextCodePoint(Utf8Iterator *iterator);
+
+BufferString *utf8Substring(BufferString *source, BufferString *destination, uint32_t beginIndex, uint32_t endIndex);
+BufferString *reverseUtf8String(BufferString *str);    // keeps multibyte sequences in the right order
+
+// index cache
+Utf8IndexCache *newUtf8IndexCache(Utf8IndexCache *cache, BufferString *str, uint32_t *offsets, uint32_t capacity);
+int32_t utf8CachedOffsetOf(Utf8IndexCache *cache, uint32_t index);